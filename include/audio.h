@@ -0,0 +1,314 @@
+//+--------------------------------------------------------------------------
+//
+// File:        audio.h
+//
+// Description:
+//
+//      Sound analysis for audio reactive effects.  Samples land in a ring
+//      buffer (from the ESP32's built-in ADC over I2S DMA, or from any other
+//      source via AddSamples), get windowed and run through a fixed-point
+//      FFT, and are binned into bands, an overall level and a beat flag.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+
+#ifdef ARDUINO_ARCH_ESP32
+#include <driver/i2s.h>
+#endif
+
+#define AUDIO_SAMPLE_RATE   20480           //  Hz; gives 80 Hz wide FFT bins
+#define AUDIO_FFT_SIZE      256             //  Must be a power of two
+#define AUDIO_RING_SIZE     1024            //  Must be a power of two and at least AUDIO_FFT_SIZE
+#define AUDIO_BANDS         16
+#define AUDIO_NOISE_FLOOR   64              //  Band magnitudes below this never count as signal
+#define AUDIO_BEAT_HOLDOFF  150             //  Minimum milliseconds between two beats
+#define AUDIO_ADC_CHANNEL   ADC1_CHANNEL_0  //  GPIO36; ADC2 can't be used while Bluetooth is running
+
+// Upper FFT bin (exclusive) of each band.  Roughly logarithmic so the bass isn't squeezed into a
+// single band; the first band starts at bin 1 to skip DC.
+
+static const uint8_t AudioBandEdges[AUDIO_BANDS] =
+{
+  2, 3, 4, 5, 7, 9, 12, 15, 19, 24, 31, 40, 51, 65, 83, AUDIO_FFT_SIZE / 2
+};
+
+struct AudioFeatures
+{
+  uint8_t Bands[AUDIO_BANDS];               //  Auto-gained band energy, 0 - 255
+  uint8_t Level;                            //  Auto-gained overall loudness, 0 - 255
+  bool    Beat;                             //  True for the one analysis in which a bass beat was detected
+  uint8_t BeatLevel;                        //  How far the beat stood above the running bass average
+};
+
+class SoundAnalyzer
+{
+  protected:
+
+    int16_t         _ring[AUDIO_RING_SIZE];
+    size_t          _writePos;
+    size_t          _newSamples;            //  Samples added since the last analysis
+
+    int16_t         _window[AUDIO_FFT_SIZE];        //  Hann window, Q15
+    int16_t         _sine[AUDIO_FFT_SIZE];          //  One full turn of sine, Q15; cosine is a quarter turn on
+    int16_t         _real[AUDIO_FFT_SIZE];
+    int16_t         _imag[AUDIO_FFT_SIZE];
+
+    uint32_t        _bandPeak;              //  Slowly decaying maximum used for the auto gain
+    uint32_t        _levelPeak;
+    uint32_t        _bassAverage;           //  Running average of the bass energy, << 4
+    unsigned long   _msLastBeat;
+    unsigned long   _usLastAnalysis;
+    bool            _bI2S;
+
+    AudioFeatures   _features;
+
+    // FFT
+    //
+    // In-place radix-2 decimation in time over _real/_imag.  Every stage halves its outputs, which
+    // keeps the magnitudes from growing so nothing can overflow 16 bits; the spectrum comes out
+    // scaled by 1/N, which the auto gain takes care of.
+
+    void FFT()
+    {
+      for (uint16_t i = 1, j = 0; i < AUDIO_FFT_SIZE; i++)
+      {
+        uint16_t bit = AUDIO_FFT_SIZE >> 1;
+        for (; j & bit; bit >>= 1)
+          j ^= bit;
+        j ^= bit;
+
+        if (i < j)
+        {
+          int16_t t = _real[i]; _real[i] = _real[j]; _real[j] = t;
+          t = _imag[i]; _imag[i] = _imag[j]; _imag[j] = t;
+        }
+      }
+
+      for (uint16_t len = 2; len <= AUDIO_FFT_SIZE; len <<= 1)
+      {
+        uint16_t half = len >> 1;
+        uint16_t step = AUDIO_FFT_SIZE / len;
+
+        for (uint16_t i = 0; i < AUDIO_FFT_SIZE; i += len)
+        {
+          for (uint16_t k = 0; k < half; k++)
+          {
+            int32_t wr =  _sine[(k * step + AUDIO_FFT_SIZE / 4) & (AUDIO_FFT_SIZE - 1)];
+            int32_t wi = -_sine[k * step];
+
+            int16_t * pr = &_real[i + k];
+            int16_t * pi = &_imag[i + k];
+
+            int32_t tr = (pr[half] * wr - pi[half] * wi) >> 15;
+            int32_t ti = (pr[half] * wi + pi[half] * wr) >> 15;
+
+            pr[half] = (pr[0] - tr) >> 1;
+            pi[half] = (pi[0] - ti) >> 1;
+            pr[0]    = (pr[0] + tr) >> 1;
+            pi[0]    = (pi[0] + ti) >> 1;
+          }
+        }
+      }
+    }
+
+    // Magnitude without a square root: max + 3/8 min is within a few percent of the real thing
+
+    static uint32_t Magnitude(int16_t re, int16_t im)
+    {
+      uint32_t a = abs(re);
+      uint32_t b = abs(im);
+      return (a > b) ? a + (b * 3 >> 3) : b + (a * 3 >> 3);
+    }
+
+    static uint8_t AutoGain(uint32_t value, uint32_t peak)
+    {
+      return (uint8_t) min(255UL, (unsigned long)(value * 255 / peak));
+    }
+
+    void Analyze()
+    {
+      unsigned long usStart = micros();
+
+      // Window the most recent AUDIO_FFT_SIZE samples out of the ring, measuring loudness on the way
+
+      size_t   readPos = (_writePos - AUDIO_FFT_SIZE) & (AUDIO_RING_SIZE - 1);
+      uint32_t sumAbs  = 0;
+
+      for (size_t i = 0; i < AUDIO_FFT_SIZE; i++)
+      {
+        int16_t sample = _ring[(readPos + i) & (AUDIO_RING_SIZE - 1)];
+        sumAbs += abs(sample);
+        _real[i] = (sample * (int32_t) _window[i]) >> 15;
+        _imag[i] = 0;
+      }
+
+      FFT();
+
+      // Bin the lower half of the spectrum into bands and follow the loudest band with the gain
+
+      uint32_t bands[AUDIO_BANDS];
+      uint32_t loudest = AUDIO_NOISE_FLOOR;
+      uint16_t bin = 1;
+
+      for (int b = 0; b < AUDIO_BANDS; b++)
+      {
+        uint32_t sum = 0;
+        uint16_t first = bin;
+        for (; bin < AudioBandEdges[b]; bin++)
+          sum += Magnitude(_real[bin], _imag[bin]);
+
+        bands[b] = sum / (bin - first);
+        loudest  = max(loudest, bands[b]);
+      }
+
+      _bandPeak = max(loudest, _bandPeak - (_bandPeak >> 6));
+      for (int b = 0; b < AUDIO_BANDS; b++)
+        _features.Bands[b] = bands[b] < AUDIO_NOISE_FLOOR ? 0 : AutoGain(bands[b], _bandPeak);
+
+      uint32_t level = sumAbs / AUDIO_FFT_SIZE;
+      _levelPeak = max(max(level, (uint32_t) AUDIO_NOISE_FLOOR), _levelPeak - (_levelPeak >> 6));
+      _features.Level = AutoGain(level, _levelPeak);
+
+      // A beat is the bass jumping half again above its running average
+
+      uint32_t bass    = bands[0] + bands[1] + bands[2];
+      uint32_t average = _bassAverage >> 4;
+      _bassAverage += bass - average;
+
+      _features.Beat = false;
+      if (bass > 3 * AUDIO_NOISE_FLOOR && bass * 2 > average * 3 && millis() - _msLastBeat > AUDIO_BEAT_HOLDOFF)
+      {
+        _features.Beat      = true;
+        _features.BeatLevel = AutoGain(bass - average, max(bass, 1U));
+        _msLastBeat         = millis();
+      }
+
+      _usLastAnalysis = micros() - usStart;
+    }
+
+#ifdef ARDUINO_ARCH_ESP32
+
+    // Drains whatever the DMA has collected since the last pass without waiting for more
+
+    void ReadI2S()
+    {
+      uint16_t raw[128];
+      size_t   bytesRead = 0;
+
+      while (i2s_read(I2S_NUM_0, raw, sizeof(raw), &bytesRead, 0) == ESP_OK && bytesRead > 0)
+      {
+        int16_t samples[128];
+        size_t  count = bytesRead / sizeof(raw[0]);
+
+        for (size_t i = 0; i < count; i++)
+          samples[i] = ((int16_t)(raw[i] & 0x0FFF) - 2048) << 3;       //  12-bit ADC, channel id in the top nibble
+
+        AddSamples(samples, count);
+      }
+    }
+
+#endif
+
+  public:
+
+    SoundAnalyzer()
+      : _writePos(0),
+        _newSamples(0),
+        _bandPeak(AUDIO_NOISE_FLOOR),
+        _levelPeak(AUDIO_NOISE_FLOOR),
+        _bassAverage(0),
+        _msLastBeat(0),
+        _usLastAnalysis(0),
+        _bI2S(false)
+    {
+      memset(_ring, 0, sizeof(_ring));
+      memset(&_features, 0, sizeof(_features));
+
+      for (int i = 0; i < AUDIO_FFT_SIZE; i++)
+      {
+        uint16_t angle = i * (65536 / AUDIO_FFT_SIZE);
+        _sine[i]   = sin16(angle);
+        _window[i] = (32767 - cos16(angle)) / 2;
+      }
+    }
+
+    // Begin
+    //
+    // Starts continuous sampling of AUDIO_ADC_CHANNEL into the I2S DMA buffers.  Without it the
+    // analyzer only sees what is handed to AddSamples.
+
+    bool Begin()
+    {
+#ifdef ARDUINO_ARCH_ESP32
+      i2s_config_t config = {};
+      config.mode                 = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_RX | I2S_MODE_ADC_BUILT_IN);
+      config.sample_rate          = AUDIO_SAMPLE_RATE;
+      config.bits_per_sample      = I2S_BITS_PER_SAMPLE_16BIT;
+      config.channel_format       = I2S_CHANNEL_FMT_ONLY_LEFT;
+      config.communication_format = I2S_COMM_FORMAT_STAND_I2S;
+      config.intr_alloc_flags     = ESP_INTR_FLAG_LEVEL1;
+      config.dma_buf_count        = 4;
+      config.dma_buf_len          = AUDIO_FFT_SIZE;
+      config.use_apll             = false;
+
+      if (i2s_driver_install(I2S_NUM_0, &config, 0, nullptr) != ESP_OK)
+        return false;
+
+      i2s_set_adc_mode(ADC_UNIT_1, AUDIO_ADC_CHANNEL);
+      i2s_adc_enable(I2S_NUM_0);
+      _bI2S = true;
+#endif
+      return _bI2S;
+    }
+
+    // AddSamples
+    //
+    // Pushes signed 16-bit mono samples into the ring.  This is the way in for any source other than
+    // the ADC, such as a decoded WAV file, which makes the analysis repeatable.
+
+    void AddSamples(const int16_t * samples, size_t count)
+    {
+      for (size_t i = 0; i < count; i++)
+      {
+        _ring[_writePos] = samples[i];
+        _writePos = (_writePos + 1) & (AUDIO_RING_SIZE - 1);
+      }
+      _newSamples += count;
+    }
+
+    // Update
+    //
+    // Call once per loop pass.  Runs at most one analysis over the newest window, and only once
+    // half a window of new audio has arrived, so a slow frame never queues up a backlog of FFTs.
+
+    void Update()
+    {
+#ifdef ARDUINO_ARCH_ESP32
+      if (_bI2S)
+        ReadI2S();
+#endif
+
+      if (_newSamples < AUDIO_FFT_SIZE / 2)
+        return;
+
+      _newSamples = 0;
+      Analyze();
+    }
+
+    const AudioFeatures & Features() const
+    {
+      return _features;
+    }
+
+    unsigned long LastAnalysisMicros() const
+    {
+      return _usLastAnalysis;
+    }
+};
@@ -0,0 +1,508 @@
+//+--------------------------------------------------------------------------
+//
+// File:        automation.h
+//
+// Description:
+//
+//      Keyframed animation of effect parameters.  Effects expose named
+//      parameters as ParamBindings, a timeline of keyframes can be attached
+//      to any of them (from code or as a text line over Bluetooth), and
+//      Evaluate() moves every bound parameter along its timeline once per
+//      frame.  Easing curves are precomputed fixed-point tables, so a
+//      parameter costs a table lookup and a multiply or two.
+//
+// History:     Oct-19-2026     tomwer      Created
+//                              tomwer      Room checked before a timeline is replaced, values range checked
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define AUTOMATION_MAX_PARAMS   64          //  Registered parameters across all effects
+#define AUTOMATION_MAX_TRACKS   64          //  Parameters animated at the same time
+#define AUTOMATION_MAX_KEYS     256         //  Keyframes shared by all tracks
+#define AUTOMATION_EASE_STEPS   256         //  Resolution of the easing tables
+#define AUTOMATION_LINE_KEYS    16          //  Keyframes in one line of text
+#define AUTOMATION_MAX_VALUE    32767.99f   //  Largest key value; keys are 16.16 fixed point
+
+#define AUTOMATION_SAVED_TRACK  3           //  Bytes per track in SaveTimelines: parameter index and key count
+#define AUTOMATION_SAVED_KEY    9           //  Bytes per key: time, value and curve
+#define AUTOMATION_TIMELINE_BYTES (AUTOMATION_MAX_TRACKS * AUTOMATION_SAVED_TRACK + AUTOMATION_MAX_KEYS * AUTOMATION_SAVED_KEY)
+
+enum ParamType
+{
+  ParamInt    = 0,
+  ParamByte   = 1,
+  ParamFloat  = 2,
+  ParamDouble = 3
+};
+
+// A parameter an effect lets the automation drive
+
+struct ParamBinding
+{
+  const char *  name;
+  ParamType     type;
+  void *        pValue;
+};
+
+enum EaseCurve
+{
+  EaseLinear      = 0,
+  EaseInQuad      = 1,
+  EaseOutQuad     = 2,
+  EaseInOutQuad   = 3,
+  EaseInOutCubic  = 4,
+  EaseInOutSine   = 5,
+  EaseHold        = 6,              //  Stay on this key's value until the next key
+  EaseCount
+};
+
+struct Keyframe
+{
+  uint32_t  msTime;                 //  From the start of the timeline
+  int32_t   value;                  //  16.16 fixed point
+  uint32_t  invSpan;                //  2^32 / time to the next key, so finding the position in a segment needs no divide
+  uint8_t   ease;                   //  Curve from this key to the next
+};
+
+class ParameterAutomation
+{
+  protected:
+
+    struct RegisteredParam
+    {
+      const char *  group;
+      ParamBinding  binding;
+    };
+
+    struct Track
+    {
+      ParamBinding  binding;
+      uint16_t      firstKey;
+      uint16_t      keyCount;
+      uint16_t      cursor;             //  Segment the timeline was in last frame
+      uint32_t      msStart;
+      uint32_t      msLength;           //  Time of the last key; the timeline loops over it
+    };
+
+    RegisteredParam _params[AUTOMATION_MAX_PARAMS];
+    size_t          _cParams;
+    Track           _tracks[AUTOMATION_MAX_TRACKS];
+    size_t          _cTracks;
+    Keyframe        _keys[AUTOMATION_MAX_KEYS];
+    size_t          _cKeys;
+    unsigned long   _usLastEvaluate;
+
+    // 16-bit eased position for each step, plus one to interpolate the last step against
+    uint16_t        _ease[EaseCount][AUTOMATION_EASE_STEPS + 1];
+
+    static float EaseFunction(int curve, float t)
+    {
+      switch (curve)
+      {
+        case EaseInQuad:      return t * t;
+        case EaseOutQuad:     return t * (2.0f - t);
+        case EaseInOutQuad:   return t < 0.5f ? 2.0f * t * t : 1.0f - 2.0f * (1.0f - t) * (1.0f - t);
+        case EaseInOutCubic:  return t < 0.5f ? 4.0f * t * t * t : 1.0f - 4.0f * (1.0f - t) * (1.0f - t) * (1.0f - t);
+        case EaseInOutSine:   return 0.5f - 0.5f * cosf(t * (float) M_PI);
+        case EaseHold:        return t < 1.0f ? 0.0f : 1.0f;
+        case EaseLinear:
+        default:              return t;
+      }
+    }
+
+    static void Write(const ParamBinding & binding, int32_t value)
+    {
+      switch (binding.type)
+      {
+        case ParamInt:    *(int *)    binding.pValue = value >> 16;                           break;
+        case ParamByte:   *(uint8_t *) binding.pValue = constrain(value >> 16, 0, 255);       break;
+        case ParamFloat:  *(float *)  binding.pValue = value / 65536.0f;                      break;
+        case ParamDouble: *(double *) binding.pValue = value / 65536.0;                       break;
+      }
+    }
+
+    static int32_t Read(const ParamBinding & binding)
+    {
+      switch (binding.type)
+      {
+        case ParamInt:    return (int32_t) constrain(*(int *) binding.pValue, -32767, 32767) * 65536;
+        case ParamByte:   return (int32_t) *(uint8_t *) binding.pValue * 65536;
+        case ParamFloat:  return (int32_t)(*(float *)  binding.pValue * 65536.0f);
+        case ParamDouble: return (int32_t)(*(double *) binding.pValue * 65536.0);
+      }
+      return 0;
+    }
+
+    const ParamBinding * FindParam(const char * name, size_t length) const
+    {
+      for (size_t i = 0; i < _cParams; i++)
+      {
+        size_t group = strlen(_params[i].group);
+        if (group + 1 + strlen(_params[i].binding.name) == length &&
+            !strncmp(name, _params[i].group, group) && name[group] == '.' &&
+            !strncmp(name + group + 1, _params[i].binding.name, length - group - 1))
+          return &_params[i].binding;
+      }
+      return nullptr;
+    }
+
+    int ParamIndex(const ParamBinding & binding) const
+    {
+      for (size_t i = 0; i < _cParams; i++)
+        if (_params[i].binding.pValue == binding.pValue)
+          return i;
+      return -1;
+    }
+
+    // Makes a track of the 'count' keys just written past the end of the key pool, clamping their
+    // curves and working out their spans
+
+    void AppendTrack(const ParamBinding & binding, size_t count, uint32_t msNow)
+    {
+      Keyframe * keys = &_keys[_cKeys];
+
+      Track & track   = _tracks[_cTracks++];
+      track.binding   = binding;
+      track.firstKey  = _cKeys;
+      track.keyCount  = count;
+      track.cursor    = 0;
+      track.msStart   = msNow;
+      track.msLength  = keys[count - 1].msTime;
+
+      for (size_t i = 0; i < count; i++)
+      {
+        keys[i].ease = min((uint8_t)(EaseCount - 1), keys[i].ease);
+
+        uint32_t span = (i + 1 < count) ? keys[i + 1].msTime - keys[i].msTime : 0;
+        keys[i].invSpan = span ? (uint32_t)(0x100000000ULL / span) : 0;
+      }
+      _cKeys += count;
+    }
+
+    // Drops a track and closes up the gap it leaves in the key pool
+
+    void RemoveTrack(size_t iTrack)
+    {
+      Track & track = _tracks[iTrack];
+      memmove(&_keys[track.firstKey], &_keys[track.firstKey + track.keyCount], (_cKeys - track.firstKey - track.keyCount) * sizeof(Keyframe));
+      _cKeys -= track.keyCount;
+
+      for (size_t i = 0; i < _cTracks; i++)
+        if (_tracks[i].firstKey > track.firstKey)
+          _tracks[i].firstKey -= track.keyCount;
+
+      _tracks[iTrack] = _tracks[--_cTracks];
+    }
+
+  public:
+
+    ParameterAutomation()
+      : _cParams(0),
+        _cTracks(0),
+        _cKeys(0),
+        _usLastEvaluate(0)
+    {
+      for (int curve = 0; curve < EaseCount; curve++)
+        for (int i = 0; i <= AUTOMATION_EASE_STEPS; i++)
+          _ease[curve][i] = (uint16_t) min(65535.0f, EaseFunction(curve, i / (float) AUTOMATION_EASE_STEPS) * 65536.0f);
+    }
+
+    // Register
+    //
+    // Makes an effect's parameters available to timelines as "group.name"
+
+    void Register(const char * group, const ParamBinding * bindings, size_t count)
+    {
+      for (size_t i = 0; i < count && _cParams < AUTOMATION_MAX_PARAMS; i++)
+        _params[_cParams++] = { group, bindings[i] };
+    }
+
+    // SetTimeline
+    //
+    // Replaces the timeline on a parameter.  Keys must be in time order; the timeline starts now and
+    // loops over the time of its last key.  No keys removes the timeline and leaves the parameter
+    // where it is.  False, with the old timeline still running, if the new one doesn't fit even
+    // with the old one's track and keys given back.
+
+    bool SetTimeline(const char * name, const Keyframe * keys, size_t count, uint32_t msNow)
+    {
+      const ParamBinding * pBinding = FindParam(name, strlen(name));
+      if (!pBinding)
+        return false;
+
+      size_t cOldTracks = 0;
+      size_t cOldKeys   = 0;
+      for (size_t i = 0; i < _cTracks; i++)
+      {
+        if (_tracks[i].binding.pValue == pBinding->pValue)
+        {
+          cOldTracks++;
+          cOldKeys += _tracks[i].keyCount;
+        }
+      }
+
+      if (count && (_cTracks - cOldTracks >= AUTOMATION_MAX_TRACKS || _cKeys - cOldKeys + count > AUTOMATION_MAX_KEYS))
+        return false;
+
+      for (size_t i = 0; i < _cTracks; i++)
+        if (_tracks[i].binding.pValue == pBinding->pValue)
+          RemoveTrack(i--);
+
+      if (count == 0)
+        return true;
+
+      memcpy(&_keys[_cKeys], keys, count * sizeof(Keyframe));
+      AppendTrack(*pBinding, count, msNow);
+      return true;
+    }
+
+    void Clear()
+    {
+      _cTracks = 0;
+      _cKeys   = 0;
+    }
+
+    // Load
+    //
+    // Parses one timeline in text form, as it arrives over Bluetooth:
+    //
+    //    comet.speed 0=0.2 2000=1.5/3 4000=0.2     time in ms = value [/ ease curve], looping every 4 s
+    //    comet.speed                               no keys; stops animating it
+    //    -                                         stops animating everything
+    //
+    // False, leaving the parameter alone, if the line doesn't parse, has more than
+    // AUTOMATION_LINE_KEYS keys, or has a value that isn't a number within +/- AUTOMATION_MAX_VALUE.
+
+    bool Load(const char * line, uint32_t msNow)
+    {
+      while (*line == ' ')
+        line++;
+
+      if (!strcmp(line, "-"))
+      {
+        Clear();
+        return true;
+      }
+
+      const char * pEnd = strchr(line, ' ');
+      size_t length = pEnd ? pEnd - line : strlen(line);
+      char name[32];
+      if (length == 0 || length >= sizeof(name))
+        return false;
+
+      memcpy(name, line, length);
+      name[length] = 0;
+
+      Keyframe keys[AUTOMATION_LINE_KEYS];
+      size_t   count = 0;
+      const char * p = line + length;
+
+      while (*p == ' ')
+        p++;
+
+      while (*p)
+      {
+        if (count == AUTOMATION_LINE_KEYS)
+          return false;
+
+        char * pNext;
+        uint32_t msTime = strtoul(p, &pNext, 10);
+        if (pNext == p || *pNext != '=')
+          return false;
+
+        p = pNext + 1;
+        float value = strtof(p, &pNext);
+        if (pNext == p || !(fabsf(value) <= AUTOMATION_MAX_VALUE))          //  written so NaN fails too
+          return false;
+
+        p = pNext;
+        uint8_t ease = EaseLinear;
+        if (*p == '/')
+          ease = strtoul(p + 1, (char **) &p, 10);
+
+        if (count && msTime < keys[count - 1].msTime)
+          return false;
+
+        keys[count++] = { msTime, (int32_t)(value * 65536.0f), 0, ease };
+
+        while (*p == ' ')
+          p++;
+      }
+
+      return SetTimeline(name, keys, count, msNow);
+    }
+
+    // Evaluate
+    //
+    // Moves every animated parameter to where its timeline is at msNow.  Each track remembers the
+    // segment it was in, so finding the current segment is usually no search at all.
+
+    void Evaluate(uint32_t msNow)
+    {
+      unsigned long usStart = micros();
+
+      for (size_t i = 0; i < _cTracks; i++)
+      {
+        Track & track = _tracks[i];
+        const Keyframe * keys = &_keys[track.firstKey];
+
+        uint32_t t = msNow - track.msStart;
+        if (track.msLength && t >= track.msLength)
+        {
+          track.msStart += (t / track.msLength) * track.msLength;
+          t = msNow - track.msStart;
+          track.cursor = 0;
+        }
+
+        while (track.cursor + 1 < track.keyCount && t >= keys[track.cursor + 1].msTime)
+          track.cursor++;
+
+        const Keyframe & key = keys[track.cursor];
+        if (track.cursor + 1 >= track.keyCount || t < key.msTime)
+        {
+          Write(track.binding, track.cursor + 1 >= track.keyCount ? key.value : keys[0].value);
+          continue;
+        }
+
+        // Position in the segment in 16 bits, then through the easing table with linear
+        // interpolation between its steps
+
+        uint32_t u     = ((uint64_t)(t - key.msTime) * key.invSpan) >> 16;
+        uint32_t index = u >> 8;
+        const uint16_t * curve = _ease[key.ease];
+        int32_t  eased = curve[index] + (((int32_t)(curve[index + 1] - curve[index]) * (int32_t)(u & 0xFF)) >> 8);
+
+        int32_t  delta = keys[track.cursor + 1].value - key.value;
+        Write(track.binding, key.value + (int32_t)(((int64_t) delta * eased) >> 16));
+      }
+
+      _usLastEvaluate = micros() - usStart;
+    }
+
+    // Snapshot
+    //
+    // Current value of every registered parameter in 16.16, in registration order, so a show can be
+    // saved and put back with Restore
+
+    size_t Snapshot(int32_t * pValues, size_t max) const
+    {
+      size_t count = min(max, _cParams);
+      for (size_t i = 0; i < count; i++)
+        pValues[i] = Read(_params[i].binding);
+      return count;
+    }
+
+    void Restore(const int32_t * pValues, size_t count)
+    {
+      for (size_t i = 0; i < count && i < _cParams; i++)
+        Write(_params[i].binding, pValues[i]);
+    }
+
+    // SaveTimelines
+    //
+    // Every timeline as bytes, to keep alongside a Snapshot: for each track the registered index of
+    // its parameter and its key count, then each key's time, value and curve.  Like a Snapshot it
+    // only fits a build with the same SchemaHash.  Returns the length, at most
+    // AUTOMATION_TIMELINE_BYTES.
+
+    size_t SaveTimelines(uint8_t * pBuffer) const
+    {
+      uint8_t * p = pBuffer;
+
+      for (size_t i = 0; i < _cTracks; i++)
+      {
+        const Track & track = _tracks[i];
+        p[0] = ParamIndex(track.binding);
+        memcpy(p + 1, &track.keyCount, 2);
+        p += AUTOMATION_SAVED_TRACK;
+
+        for (size_t k = 0; k < track.keyCount; k++)
+        {
+          const Keyframe & key = _keys[track.firstKey + k];
+          memcpy(p,     &key.msTime, 4);
+          memcpy(p + 4, &key.value,  4);
+          p[8] = key.ease;
+          p += AUTOMATION_SAVED_KEY;
+        }
+      }
+      return p - pBuffer;
+    }
+
+    // LoadTimelines
+    //
+    // Puts back what SaveTimelines wrote, replacing every timeline, with each one starting over
+    // from its first key at msNow.  False, with no timelines at all, if the bytes don't parse.
+
+    bool LoadTimelines(const uint8_t * pBuffer, size_t length, uint32_t msNow)
+    {
+      const uint8_t * p    = pBuffer;
+      const uint8_t * pEnd = pBuffer + length;
+
+      Clear();
+      while (p < pEnd)
+      {
+        size_t   param = p[0];
+        uint16_t count = 0;
+        if (p + AUTOMATION_SAVED_TRACK <= pEnd)
+          memcpy(&count, p + 1, 2);
+        p += AUTOMATION_SAVED_TRACK;
+
+        if (param >= _cParams || count == 0 || p + count * AUTOMATION_SAVED_KEY > pEnd ||
+            _cTracks >= AUTOMATION_MAX_TRACKS || _cKeys + count > AUTOMATION_MAX_KEYS)
+        {
+          Clear();
+          return false;
+        }
+
+        for (size_t k = 0; k < count; k++, p += AUTOMATION_SAVED_KEY)
+        {
+          Keyframe & key = _keys[_cKeys + k];
+          memcpy(&key.msTime, p,     4);
+          memcpy(&key.value,  p + 4, 4);
+          key.ease = p[8];
+        }
+        AppendTrack(_params[param].binding, count, msNow);
+      }
+      return true;
+    }
+
+    // SchemaHash
+    //
+    // FNV-1a over the registered names and types; a saved snapshot only fits if this still matches
+
+    uint32_t SchemaHash() const
+    {
+      uint32_t hash = 2166136261UL;
+      for (size_t i = 0; i < _cParams; i++)
+      {
+        for (const char * p = _params[i].group; *p; p++)
+          hash = (hash ^ (uint8_t) *p) * 16777619UL;
+        for (const char * p = _params[i].binding.name; *p; p++)
+          hash = (hash ^ (uint8_t) *p) * 16777619UL;
+        hash = (hash ^ (uint8_t) _params[i].binding.type) * 16777619UL;
+      }
+      return hash;
+    }
+
+    size_t ParamCount() const
+    {
+      return _cParams;
+    }
+
+    size_t TrackCount() const
+    {
+      return _cTracks;
+    }
+
+    unsigned long LastEvaluateMicros() const
+    {
+      return _usLastEvaluate;
+    }
+};
@@ -9,6 +9,7 @@
 //      Bouncing Ball effect on an LED strip
 //
 // History:     Oct-04-2020     davepl      Created
+//              Oct-19-2026     tomwer      Trails in 16 bits through HighPrecisionBuffer
 //
 //---------------------------------------------------------------------------
 
@@ -18,6 +19,9 @@
 #include <FastLED.h>
 #include <vector>
 
+#include "automation.h"
+#include "framebuffer16.h"
+
 extern CRGB h_LEDs[];
 
 // #define ARRAYSIZE(x) (sizeof(x)/sizeof(x[0]))       // count elements in a static array
@@ -48,7 +52,7 @@ class BouncingBallEffect
     const double Gravity = -9.81;                                   // Because PHYSICS!
     const double StartHeight = 1;                                   // Drop balls from max height initially
     const double ImpactVelocity = InitialBallSpeed(StartHeight);
-    const double SpeedKnob = 4.0;                                   // Higher values will slow the effect
+    double SpeedKnob = 4.0;                                         // Higher values will slow the effect
 
     std::vector<double> ClockTimeAtLastBounce, Height, BallSpeed, Dampening;
     std::vector<CRGB>   Colors;
@@ -60,6 +64,29 @@ class BouncingBallEffect
         return (double)(tv.tv_usec / 1000000.0 + (double) tv.tv_sec);
     }
 
+    // Moves ball i along its arc, bouncing it off the ground, and returns the pixel it is at now
+
+    size_t Advance(size_t i)
+    {
+        double TimeSinceLastBounce = (Time() - ClockTimeAtLastBounce[i]) / max(0.1, SpeedKnob);     // the knob may be animated, so never down to 0
+
+        // Use standard constant acceleration function - https://en.wikipedia.org/wiki/Acceleration
+        Height[i] = 0.5 * Gravity * pow(TimeSinceLastBounce, 2.0) + BallSpeed[i] * TimeSinceLastBounce;
+
+        // Ball hits ground - bounce!
+        if (Height[i] < 0)
+        {
+            Height[i] = 0;
+            BallSpeed[i] = Dampening[i] * BallSpeed[i];
+            ClockTimeAtLastBounce[i] = Time();
+
+            if (BallSpeed[i] < 0.01)
+                BallSpeed[i] = InitialBallSpeed(StartHeight) * Dampening[i];
+        }
+
+        return (size_t)(Height[i] * (_cLength - 1) / StartHeight);
+    }
+
   public:
 
     // BouncingBallEffect
@@ -88,6 +115,17 @@ class BouncingBallEffect
         }
     }
 
+    // Parameters
+    //
+    // Fills pOut with bindings for the parameter automation in automation.h and returns how many
+
+    size_t Parameters(ParamBinding * pOut)
+    {
+        pOut[0] = { "speed", ParamDouble, &SpeedKnob };
+        pOut[1] = { "fade",  ParamByte,   &_fadeRate };
+        return 2;
+    }
+
     // Draw
     //
     // Draw each of the balls.  When any ball settles with too little energy, it it "kicked" to restart it
@@ -106,33 +144,46 @@ class BouncingBallEffect
 
         for (size_t i = 0; i < _cBalls; i++)
         {
-            double TimeSinceLastBounce = (Time() - ClockTimeAtLastBounce[i]) / SpeedKnob;
+            size_t position = Advance(i);
 
-            // Use standard constant acceleration function - https://en.wikipedia.org/wiki/Acceleration
-            Height[i] = 0.5 * Gravity * pow(TimeSinceLastBounce, 2.0) + BallSpeed[i] * TimeSinceLastBounce;
+            h_LEDs[position]   += Colors[i];
+            h_LEDs[position+1] += Colors[i];
 
-            // Ball hits ground - bounce!
-            if (Height[i] < 0)
+            if (_bMirrored)
             {
-                Height[i] = 0;
-                BallSpeed[i] = Dampening[i] * BallSpeed[i];
-                ClockTimeAtLastBounce[i] = Time();
-
-                if (BallSpeed[i] < 0.01)
-                    BallSpeed[i] = InitialBallSpeed(StartHeight) * Dampening[i];
+                h_LEDs[_cLength - 1 - position] += Colors[i];
+                h_LEDs[_cLength - position]     += Colors[i];
             }
+        }
+    }
 
-            size_t position = (size_t)(Height[i] * (_cLength - 1) / StartHeight);
+    // Draw
+    //
+    // The same balls with their trails kept in 16 bits, so a light fade runs smoothly all the way down rather than
+    // stepping and then sticking at the bottom of the 8-bit range.  Brightness and gamma are applied as the frame
+    // is quantized into h_LEDs, so it goes to the strip unscaled.
 
-            h_LEDs[position]   += Colors[i];
-            h_LEDs[position+1] += Colors[i];
+    void Draw(HighPrecisionBuffer & buffer, uint8_t brightness)
+    {
+        if (_fadeRate != 0)
+            buffer.FadeToBlackBy(_fadeRate);
+        else
+            buffer.Clear();
+
+        for (size_t i = 0; i < _cBalls; i++)
+        {
+            size_t position = Advance(i);
+
+            buffer.AddPixel(position,   Colors[i]);
+            buffer.AddPixel(position+1, Colors[i]);
 
             if (_bMirrored)
             {
-                h_LEDs[_cLength - 1 - position] += Colors[i];
-                h_LEDs[_cLength - position]     += Colors[i];
+                buffer.AddPixel(_cLength - 1 - position, Colors[i]);
+                buffer.AddPixel(_cLength - position,     Colors[i]);
             }
         }
-        delay(20);
+
+        buffer.Quantize(h_LEDs, brightness);
     }
 };
\ No newline at end of file
@@ -16,38 +16,83 @@
 #define FASTLED_INTERNAL
 #include <FastLED.h>
 
+#include "framebuffer16.h"
+#include "automation.h"
+#include "huetable.h"
+
 extern CRGB h_LEDs[];
 
+// DrawComet's knobs, which the parameter automation can move while it runs
+byte   cometFadeAmt  = 64;              // Fraction of 256 to fade a pixel by if it is chosen to be faded
+int    cometDeltaHue = 4;               // How far to step the cycling hue each draw cycle
+double cometSpeed    = 0.5;             // How far to advance the comet every frame
+
+static const ParamBinding CometParams[] =
+{
+    { "fade",   ParamByte,   &cometFadeAmt  },
+    { "hue",    ParamInt,    &cometDeltaHue },
+    { "speed",  ParamDouble, &cometSpeed    },
+};
+
 void DrawComet(){
     
     // FastLED.clear(false);              // Uncomment this for cylon eye/knight rider effect
 
-    const byte fadeAmt = 64;            // Fraction of 256 to fade a pixel by if it is chosen to be faded
     const int cometSize = 5;            // Size of the comet in pixels
-    const int deltaHue  = 4;            // How far to step the cycling hue each draw cycle
-    const double cometSpeed = 0.5;      // How far to advance the comet every frame
 
     static byte hue = HUE_RED;          // Current color
     static int iDirection = 1;          // Current direction (-1 or +1)
     static double iPos = 0.0;           // Current comet position on strip
 
-    hue += deltaHue;                    // Update the comet color
+    hue += cometDeltaHue;               // Update the comet color
     iPos += iDirection * cometSpeed;    // Update the comet position
 
-    //  Flip the comet direction when it hits either end
-    if (iPos == (NUM_LEDS - cometSize) || iPos == 0)
-        iDirection *= -1;
+    //  Flip the comet direction when it hits either end.  The speed can change under us, so the
+    //  position won't always land exactly on the end; pin it there instead.
+    if (iPos >= NUM_LEDS - cometSize){
+        iPos = NUM_LEDS - cometSize;
+        iDirection = -1;
+    }
+    else if (iPos <= 0){
+        iPos = 0;
+        iDirection = 1;
+    }
 
     //  Draw the comet at its current position
     for (int i = 0; i < cometSize; i++)
-        h_LEDs[(int)iPos + i].setHue(hue);
+        h_LEDs[(int)iPos + i] = RainbowHues[hue];
     
     // Randomly fade the LEDs  --  comment this section for cylon eye/knight rider effect 
     for (int j = 0; j < NUM_LEDS; j++)
         // if (random(10) > 5)                              //  Adds randomness to the fade of the comet tail
-            h_LEDs[j] = h_LEDs[j].fadeToBlackBy(fadeAmt);
+            h_LEDs[j] = h_LEDs[j].fadeToBlackBy(cometFadeAmt);
+}
+
+// Same comet as DrawComet, but drawn and faded in a 16-bit buffer so the tail fades all the way out
+// smoothly instead of banding and sticking at low values.  Brightness is applied in the buffer's output
+// pass too, so show the frame unscaled.
+void DrawCometHP(HighPrecisionBuffer & buffer, uint8_t brightness = 255){
 
-    delay(20);
+    const byte fadeAmt = 64;
+    const int cometSize = 5;
+    const int deltaHue  = 4;
+    const double cometSpeed = 0.5;
+
+    static byte hue = HUE_RED;
+    static int iDirection = 1;
+    static double iPos = 0.0;
+
+    hue += deltaHue;
+    iPos += iDirection * cometSpeed;
+
+    if (iPos == (NUM_LEDS - cometSize) || iPos == 0)
+        iDirection *= -1;
+
+    for (int i = 0; i < cometSize; i++)
+        buffer.SetPixel((int)iPos + i, RainbowHues[hue]);
+
+    buffer.FadeToBlackBy(fadeAmt);
+    buffer.Quantize(h_LEDs, brightness);
 }
 
 // Uses the ledgfx.h header
@@ -68,25 +113,23 @@ void DrawCometGfx(){
         iDirection *= -1;
     
     for (int i = 0; i < cometSize; i++)
-        FastLED.leds()[iPos + i].setHue(hue);
+        FastLED.leds()[iPos + i] = RainbowHues[hue];
     
     // Randomly fade the LEDs
     for (int j = 0; j < FastLED.count(); j++)
         if (random(10) > 5)
             FastLED.leds()[j] = FastLED.leds()[j].fadeToBlackBy(fadeAmt);  
-
-    delay(30);
 }
 
+static const HueTable Comet3Hues(194, 127);             //  DrawComet3's hues at its fixed saturation and value
+
+//  Paced by its 20 ms frame interval in the effect table
 void DrawComet3(){
-    
-    EVERY_N_MILLISECONDS(20){
-        
-        fadeToBlackBy(h_LEDs, NUM_LEDS, 64);
-        int cometSize = 15;
-        int iPos = beatsin16(32, 0, NUM_LEDS - cometSize);
-        byte hue = beatsin8(30);
-        for (int i = iPos; i < iPos + cometSize; i++)
-        h_LEDs[i] = CHSV(hue, 194, 127);      //  (hue, saturation, value)  Blue = hue 160
-    }
+
+    fadeToBlackBy(h_LEDs, NUM_LEDS, 64);
+    int cometSize = 15;
+    int iPos = beatsin16(32, 0, NUM_LEDS - cometSize);
+    byte hue = beatsin8(30);
+    for (int i = iPos; i < iPos + cometSize; i++)
+    h_LEDs[i] = Comet3Hues[hue];          //  CHSV(hue, 194, 127) from the table  Blue = hue 160
 }
\ No newline at end of file
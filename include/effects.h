@@ -0,0 +1,140 @@
+//+--------------------------------------------------------------------------
+//
+// File:        effects.h
+//
+// Description:
+//
+//      The effect registry: every effect's state, the wrappers that draw
+//      them, the table of keys and frame intervals main.cpp selects them
+//      from, and the parameter groups they register with the automation.
+//      The host tests include this same file, so what they draw and time is
+//      exactly what the sketch runs.
+//
+//      Whoever includes this defines NUM_LEDS, UK_LEDS, MATRIX_WIDTH and
+//      MATRIX_HEIGHT, h_LEDs, h_Brightness and ARRAYSIZE first.
+//
+// History:     Oct-19-2026     tomwer      Created, from the table in main.cpp
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+
+#include "ledgfx.h"
+#include "marquee.h"
+#include "twinkle.h"
+#include "comet.h"
+#include "bounce.h"
+#include "fire.h"
+#include "lightmystrip.h"
+#include "transition.h"
+#include "audio.h"
+#include "soundfx.h"
+#include "layout.h"
+#include "spatialfx.h"
+#include "fire2d.h"
+#include "automation.h"
+
+//  Bouncing Ball Effect
+//
+// (length, count, fade, mirrored)
+// Creating instance of BouncingBallEffect called balls
+BouncingBallEffect balls(NUM_LEDS, 8, 32, true);
+BouncingBallEffect ballsHP(NUM_LEDS, 8, 16, true);                // longer trails, which the 16-bit buffer fades out smoothly
+IceFireEffect ice(NUM_LEDS, 30, 100, 3, 4, true, true);           // f-f = end -> 0 : t-f = 0 -> end : f-t = center -> out : t-t = ends -> center
+FireEffect fire(NUM_LEDS, 30, 100, 3, 4, true, true);             // f-f = end -> 0 : t-f = 0 -> end : f-t = center -> out : t-t = ends -> center
+FireEffect beatFire(NUM_LEDS, 30, 100, 3, 4, true, true);         // its own heat, so blending fire into beat fire doesn't step one fire twice a frame
+Fire2DEffect matrixFire(MATRIX_WIDTH, MATRIX_HEIGHT, 60, 120, 3, 2, true);      // (width, height, cooling, sparking, sparks, sparkHeight, serpentine)
+
+//  Physical layout of the strip.  It's a straight run today; swap MakeStripCoords for MakeRingCoords or MakeMatrixCoords in
+//  setup() to match the hardware and the spatial effects follow along.
+LedCoord  layoutCoords[NUM_LEDS];
+LedLayout layout(NUM_LEDS);
+
+HighPrecisionBuffer cometBuffer(NUM_LEDS, 2.2f);                  //  16-bit frame for DrawCometHP; gamma and brightness happen in Quantize
+HighPrecisionBuffer ballsBuffer(NUM_LEDS, 2.2f);                  //  Likewise for ballsHP
+
+SoundAnalyzer audio;                                              //  Samples the microphone on AUDIO_ADC_CHANNEL
+
+void MyIceFire(){
+    FastLED.clear();
+    ice.DrawIceFire();
+};
+
+void MyFire(){
+    FastLED.clear();
+    fire.DrawFire();
+};
+
+void MyBeatFire(){
+    const AudioFeatures & features = audio.Features();
+    if (features.Beat)
+        beatFire.Ignite(1 + features.BeatLevel / 64);
+    FastLED.clear();
+    beatFire.DrawFire();
+};
+
+//-----------------------------------------------------------------------------------------------------------------------------
+// Effect registry
+//
+//  Every effect, once: the Bluetooth key that selects it, its name, how to draw a frame, its frame interval and the group
+//  of automatable parameters it reads.  The frame interval is the pacing that used to be a delay() inside each effect;
+//  the loop does the waiting so that two effects can be drawn in the same pass while a transition runs.  Static effects
+//  are drawn once when selected and then cost nothing until the next key.  An effect that applies h_Brightness itself,
+//  with more precision than FastLED's 8-bit scaling, sets bScaled so its frames go to the strip unscaled.
+
+struct LedEffect
+{
+  char            key;                //  Bluetooth key that selects the effect
+  const char *    name;
+  EffectDrawFunc  draw;               //  Draws one frame into h_LEDs
+  unsigned long   msPerFrame;         //  Minimum time between frames, or STATIC_EFFECT
+  const char *    params;             //  Parameter group registered with the automation, or nullptr
+  bool            bScaled;            //  Frames already have h_Brightness applied; false unless given
+};
+
+#define STATIC_EFFECT   0
+
+static const LedEffect Effects[] =
+{
+  { 'a', "comet",           DrawComet,                                                      20, "comet"   },   // dynamic
+  { 'b', "comet gfx",       DrawCometGfx,                                                   30, nullptr   },   // dynamic
+  { 'c', "comet 3",         DrawComet3,                                                     20, nullptr   },   // dynamic
+  { 'd', "bouncing balls",  []{ balls.Draw(); },                                            20, "balls"   },   // dynamic
+  { 'e', "marquee",         DrawMarquee,                                                    50, nullptr   },   // dynamic
+  { 'f', "green pixels",    []{ DrawPixels(h_LEDs[0], NUM_LEDS, CRGB::Green); }, STATIC_EFFECT, nullptr   },   // static
+  { 'g', "twinkle",         DrawTwinkle,                                         TWINKLE_SPEED, nullptr   },   // dynamic
+  { 'h', "solid green",     []{ fill_solid(h_LEDs, NUM_LEDS, CRGB::Green); },    STATIC_EFFECT, nullptr   },   // static
+  { 'i', "twinkle one",     DrawTwinkleOne,                                                200, nullptr   },   // dynamic
+  { 'j', "first pixel red", []{ h_LEDs[0] = CRGB::Red; },                        STATIC_EFFECT, nullptr   },   // static
+  { 'k', "full strip",      lightFullStrip,                                      STATIC_EFFECT, nullptr   },   // static
+  { 'l', "fire",            MyFire,                                                         10, "fire"    },   // dynamic
+  { 'm', "ice fire",        MyIceFire,                                                      10, "ice"     },   // dynamic
+  { 'n', "flag",            UkrainFlag,                                          STATIC_EFFECT, nullptr   },   // static
+  { 'o', "off",             []{ FastLED.clear(); },                              STATIC_EFFECT, nullptr   },   // sets all to HIGH / OFF / 0
+  { 'p', "vu meter",        []{ DrawVUMeter(audio.Features()); },                           10, nullptr   },   // sound reactive
+  { 'q', "spectrum",        []{ DrawSpectrum(audio.Features()); },                          10, nullptr   },   // sound reactive
+  { 'r', "beat fire",       MyBeatFire,                                                     10, "beatfire" },   // sound reactive
+  { 's', "plane sweep",     []{ DrawPlaneSweep(layout, AxisX, CRGB::Blue); },               20, nullptr   },   // spatial
+  { 't', "radial wave",     []{ DrawRadialWave(layout); },                                  20, nullptr   },   // spatial
+  { 'u', "comet hp",        []{ DrawCometHP(cometBuffer, h_Brightness); },                  20, nullptr, true },   // dynamic, 16-bit
+  { 'v', "matrix fire",     []{ matrixFire.DrawFire(h_LEDs); },                             16, nullptr   },   // dynamic, 2D
+  { 'w', "balls hp",        []{ ballsHP.Draw(ballsBuffer, h_Brightness); },                 20, "ballshp", true },   // dynamic, 16-bit
+};
+
+//  Every parameter group named in Effects, registered in the same order each time so the automation's schema hash, and
+//  with it the saved show, stays valid from one boot to the next
+void RegisterParameters(ParameterAutomation & automation){
+
+  ParamBinding bindings[4];
+
+  automation.Register("comet",    CometParams, ARRAYSIZE(CometParams));
+  automation.Register("fire",     bindings, fire.Parameters(bindings));
+  automation.Register("beatfire", bindings, beatFire.Parameters(bindings));
+  automation.Register("ice",      bindings, ice.Parameters(bindings));
+  automation.Register("balls",    bindings, balls.Parameters(bindings));
+  automation.Register("ballshp",  bindings, ballsHP.Parameters(bindings));
+}
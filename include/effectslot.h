@@ -0,0 +1,50 @@
+//+--------------------------------------------------------------------------
+//
+// File:        effectslot.h
+//
+// Description:
+//
+//      How effects are paced on the event loop: each running effect has a
+//      slot with a timer that repeats at its frame interval, or fires once
+//      for a static effect, and every frame drawn re-arms the one-shot
+//      stats and power timers.  Once nothing is animating there are no
+//      timers left and the loop sleeps until the next key.  main.cpp and
+//      the event loop test both schedule through these.
+//
+// History:     Oct-19-2026     tomwer      Created, from main.cpp
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include "eventloop.h"
+#include "effects.h"
+
+#define STATS_MS              250                                 //  OLED refresh interval while frames are being drawn
+#define POWER_MS              1000                                //  Power estimate refresh interval while frames are being drawn
+
+//  An effect that is running, and the timer that paces its frames
+struct EffectSlot
+{
+  const LedEffect * pEffect;
+  WheelTimer        timer;
+};
+
+//  Puts an effect in a slot and arms the slot's timer: once for a static effect, otherwise at the effect's frame interval
+void StartSlot(EventLoop & events, EffectSlot & slot, const LedEffect * pEffect, unsigned long msDelay){
+
+  slot.pEffect = pEffect;
+  if (pEffect->msPerFrame == STATIC_EFFECT)
+    events.Schedule(slot.timer, msDelay);
+  else
+    events.Schedule(slot.timer, msDelay, pEffect->msPerFrame);
+}
+
+//  Called after every frame: the stats and power timers only run while frames are being drawn
+void FrameDrawn(EventLoop & events, WheelTimer & statsTimer, WheelTimer & powerTimer){
+
+  if (!statsTimer.bArmed)
+    events.Schedule(statsTimer, STATS_MS);
+  if (!powerTimer.bArmed)
+    events.Schedule(powerTimer, POWER_MS);
+}
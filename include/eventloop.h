@@ -0,0 +1,263 @@
+//+--------------------------------------------------------------------------
+//
+// File:        eventloop.h
+//
+// Description:
+//
+//      Blocking event queue for the main loop.  Input is posted from another
+//      task (the Bluetooth callback) and everything periodic is a timer on
+//      the TimerWheel, which runs inside Wait().  Between the two, Wait()
+//      sleeps until the next input or deadline, so an idle strip costs no
+//      CPU at all.  Also keeps track of wakeups per second and how much of
+//      the time the loop was busy.
+//
+//      The clock, the input and the sleeping come from an EventSource: a
+//      FreeRTOS stream buffer on the device, a scripted one in the host tests.
+//
+// History:     Oct-19-2026     tomwer      Created
+//                              tomwer      Timers moved onto the timer wheel
+//                              tomwer      Clock and queue behind EventSource
+//                              tomwer      Input bytes through a stream buffer
+//                              tomwer      Runs on without input if the buffer can't be had
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+
+#ifdef ARDUINO_ARCH_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/stream_buffer.h>
+#include <freertos/task.h>
+#endif
+
+#include "timerwheel.h"
+
+#define EVENT_WAIT_FOREVER  WHEEL_NO_DEADLINE
+#define EVENT_MAX_SLEEP_MS  60000           //  Longest single FreeRTOS sleep, which keeps pdMS_TO_TICKS from overflowing
+#define EVENT_INPUT_BYTES   512             //  Input buffered for the loop; a few command lines' worth
+#define EVENT_MIN_INPUT_BYTES 64            //  What to ask for when the heap can't spare EVENT_INPUT_BYTES
+#define EVENT_POST_WAIT_MS  100             //  How long the posting task waits for room before giving up on the rest
+#define EVENT_READ_CHUNK    32              //  Bytes taken out of the buffer per wakeup
+
+enum EventType
+{
+  InputEvent  = 0                   //  A byte arrived over Bluetooth
+};
+
+struct LoopEvent
+{
+  EventType type;
+  char      key;
+};
+
+// EventSource
+//
+// Where the loop's time and events come from, and how it sleeps while there are none
+
+class EventSource
+{
+  public:
+
+    virtual ~EventSource() {}
+
+    virtual bool Begin(size_t inputBytes) = 0;
+
+    virtual unsigned long Millis() = 0;
+    virtual unsigned long Micros() = 0;
+
+    // PostInput
+    //
+    // Hands over input bytes from the one task they arrive on.  Rather than drop bytes when the
+    // buffer is full it waits up to EVENT_POST_WAIT_MS for the loop to make room, and returns how
+    // many were taken.
+
+    virtual size_t PostInput(const uint8_t * bytes, size_t count) = 0;
+
+    // Receive
+    //
+    // Sleeps until input is posted or msTimeout has passed, EVENT_WAIT_FOREVER for no limit.
+    // True if it returns with an event, an InputEvent for each byte in the order they were posted.
+
+    virtual bool Receive(LoopEvent & event, uint32_t msTimeout) = 0;
+};
+
+#ifdef ARDUINO_ARCH_ESP32
+
+class FreeRTOSEventSource : public EventSource
+{
+  protected:
+
+    // One stream buffer carries every byte and wakes the loop once per batch, where a queue of
+    // single key events would take a send and a wakeup per byte.  If it couldn't be allocated the
+    // loop still sleeps and runs its timers, and input is turned away.
+
+    StreamBufferHandle_t    _input;
+    uint8_t                 _pending[EVENT_READ_CHUNK];     //  Received in one go and handed out a byte at a time
+    size_t                  _cPending;
+    size_t                  _iPending;
+
+  public:
+
+    FreeRTOSEventSource()
+      : _input(nullptr),
+        _cPending(0),
+        _iPending(0)
+    {
+    }
+
+    bool Begin(size_t inputBytes) override
+    {
+      if (!_input)
+        _input = xStreamBufferCreate(inputBytes, 1);
+      return _input != nullptr;
+    }
+
+    unsigned long Millis() override
+    {
+      return millis();
+    }
+
+    unsigned long Micros() override
+    {
+      return micros();
+    }
+
+    size_t PostInput(const uint8_t * bytes, size_t count) override
+    {
+      if (!_input)
+        return 0;
+      return xStreamBufferSend(_input, bytes, count, pdMS_TO_TICKS(EVENT_POST_WAIT_MS));
+    }
+
+    bool Receive(LoopEvent & event, uint32_t msTimeout) override
+    {
+      if (_iPending == _cPending)
+      {
+        TickType_t ticks = msTimeout == EVENT_WAIT_FOREVER ? portMAX_DELAY : pdMS_TO_TICKS(min(msTimeout, (uint32_t) EVENT_MAX_SLEEP_MS));
+        if (!_input)
+        {
+          vTaskDelay(ticks);
+          return false;
+        }
+        _cPending = xStreamBufferReceive(_input, _pending, sizeof(_pending), ticks);
+        _iPending = 0;
+        if (!_cPending)
+          return false;
+      }
+
+      event = { InputEvent, (char) _pending[_iPending++] };
+      return true;
+    }
+};
+
+#endif
+
+class EventLoop
+{
+  protected:
+
+    EventSource &   _source;
+    TimerWheel      _timers;
+
+    unsigned long   _usWindowStart;         //  Start of the current one second measuring window
+    unsigned long   _usBlocked;             //  Time spent asleep in this window
+    unsigned long   _wakeups;
+    unsigned int    _wakeupsPerSecond;
+    uint8_t         _utilization;           //  Percent of the last window spent awake
+
+    void UpdateStats(unsigned long usBlocked)
+    {
+      _usBlocked += usBlocked;
+      _wakeups++;
+
+      unsigned long usElapsed = _source.Micros() - _usWindowStart;
+      if (usElapsed >= 1000000UL)
+      {
+        unsigned long usBusy = usElapsed - min(usElapsed, _usBlocked);
+
+        _utilization      = ((uint64_t) usBusy * 100 + usElapsed / 2) / usElapsed;        //  to the nearest percent, so idle reads 0
+        _wakeupsPerSecond = (uint64_t) _wakeups * 1000000UL / usElapsed;
+        _usWindowStart    = _source.Micros();
+        _usBlocked        = 0;
+        _wakeups          = 0;
+      }
+    }
+
+  public:
+
+    EventLoop(EventSource & source)
+      : _source(source),
+        _usWindowStart(0),
+        _usBlocked(0),
+        _wakeups(0),
+        _wakeupsPerSecond(0),
+        _utilization(0)
+    {
+    }
+
+    bool Begin(size_t inputBytes = EVENT_INPUT_BYTES)
+    {
+      _timers.Begin(_source.Millis());
+      _usWindowStart = _source.Micros();
+      return _source.Begin(inputBytes);
+    }
+
+    // PostInput
+    //
+    // Call from the task input arrives on.  Waits for room if the loop is behind; returns how many
+    // bytes were taken.
+
+    size_t PostInput(const uint8_t * bytes, size_t count)
+    {
+      return _source.PostInput(bytes, count);
+    }
+
+    // Schedule
+    //
+    // Arms a timer msDelay from now, repeating every msPeriod if that isn't 0.  Only call from the
+    // loop task; the wheel isn't locked.
+
+    void Schedule(WheelTimer & timer, unsigned long msDelay, unsigned long msPeriod = 0)
+    {
+      _timers.Add(timer, _source.Millis(), msDelay, msPeriod);
+    }
+
+    void Cancel(WheelTimer & timer)
+    {
+      _timers.Remove(timer);
+    }
+
+    // Wait
+    //
+    // Runs timers as they come due and otherwise sleeps until an event is posted, then returns it.
+    // With no event and no timers it sleeps indefinitely.
+
+    void Wait(LoopEvent & event)
+    {
+      for (;;)
+      {
+        _timers.Advance(_source.Millis());
+
+        uint32_t msWait = _timers.NextDeadline(_source.Millis());
+
+        unsigned long usStart = _source.Micros();
+        bool bEvent = _source.Receive(event, msWait);
+        UpdateStats(_source.Micros() - usStart);
+
+        if (bEvent)
+          return;
+      }
+    }
+
+    unsigned int WakeupsPerSecond() const
+    {
+      return _wakeupsPerSecond;
+    }
+
+    uint8_t Utilization() const
+    {
+      return _utilization;
+    }
+};
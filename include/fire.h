@@ -19,6 +19,7 @@
 #include <FastLED.h>
 
 #include "ledgfx.h"
+#include "automation.h"
 
 class FireEffect{
     
@@ -43,6 +44,18 @@ class FireEffect{
     static const byte BlendNeighbor3 = 1;
     static const byte BlendTotal = (BlendSelf + BlendNeighbor1 + BlendNeighbor2 + BlendNeighbor3);
 
+    // Drift heat up and diffuse it a little bit; working up from the top, each cell sees the undiffused ones below it
+
+    void DriftHeat(){
+
+        for (int i = 0; i < Size; i++)
+            heat[i] = (heat[i] * BlendSelf + 
+                       heat[(i + 1) % Size] * BlendNeighbor1 +
+                       heat[(i + 2) % Size] * BlendNeighbor2 +
+                       heat[(i + 3) % Size] * BlendNeighbor3)
+                       / BlendTotal;
+    }
+
   public:
 
     FireEffect(int size, int cooling = 20, int sparking = 100, int sparks = 3, int sparkHeight = 4, bool breversed = true, bool bmirrored = true)
@@ -66,6 +79,31 @@ class FireEffect{
         delete [] heat;
     }
 
+    // Ignite
+    //
+    // Forces extra sparks into the flame core on demand, eg: on a beat from the sound analyzer
+
+    virtual void Ignite(int sparks){
+
+        for (int i = 0; i < sparks; i++){
+
+            int y = Size - 1 - random(SparkHeight);
+            heat[y] = qadd8(heat[y], random(160, 255));
+        }
+    }
+
+    // Parameters
+    //
+    // Fills pOut with bindings for the parameter automation in automation.h and returns how many
+
+    size_t Parameters(ParamBinding * pOut){
+
+        pOut[0] = { "cooling",  ParamInt, &Cooling };
+        pOut[1] = { "sparking", ParamInt, &Sparking };
+        pOut[2] = { "sparks",   ParamInt, &Sparks };
+        return 3;
+    }
+
     virtual void DrawFire(){
 
         // First cool each cell by a little bit
@@ -73,12 +111,7 @@ class FireEffect{
             heat[i] = max(0L, heat[i] - random(0, ((Cooling * 10) / Size) + 2));
         
         // Next drift heat up and diffuse it a little bit
-        for (int i = 0; i < Size; i++)
-            heat[i] = (heat[i] * BlendSelf + 
-                       heat[(i + 1) % Size] * BlendNeighbor1 +
-                       heat[(i + 2) % Size] * BlendNeighbor2 +
-                       heat[(i + 3) % Size] * BlendNeighbor3)
-                       / BlendTotal;
+        DriftHeat();
 
         // Randomly ignite new sparks down in the flame core
         for (int i = 0; i < Sparks; i++){
@@ -149,6 +182,18 @@ class IceFireEffect{
         delete [] cold;
     }
 
+    // Parameters
+    //
+    // Fills pOut with bindings for the parameter automation in automation.h and returns how many
+
+    size_t Parameters(ParamBinding * pOut){
+
+        pOut[0] = { "cooling",  ParamInt, &Cooling };
+        pOut[1] = { "sparking", ParamInt, &Sparking };
+        pOut[2] = { "sparks",   ParamInt, &Sparks };
+        return 3;
+    }
+
     virtual void DrawIceFire(){
 
         // First cool each cell by a little bit
@@ -0,0 +1,212 @@
+//+--------------------------------------------------------------------------
+//
+// File:        fire2d.h
+//
+// Description:
+//
+//      A flame simulation for LED matrix panels, using the same cool /
+//      drift and diffuse / spark / colorize steps as FireEffect in fire.h
+//
+//      The heat drifts up through the diffusion alone, as in FireEffect,
+//      with the same weights: a panel whose rows are each one heat all the
+//      way across burns exactly like the strip.  Rows are reached through
+//      row pointers, so each diffused row is written to a spare and swapped
+//      in rather than copied, and the stencil works on four cells at a time
+//      in packed bytes.
+//
+// History:     Oct-19-2026     tomwer      Created
+//                              tomwer      Drift by diffusion only, FireEffect's weights
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+#include <string.h>
+
+class Fire2DEffect{
+
+  protected:
+
+    int     Width;                  // Columns in the panel
+    int     Height;                 // Rows in the panel
+    int     Cooling;                // Rate the pixels cool off
+    int     Sparks;                 // How many sparks will be attempted per column each frame, in eighths
+    int     SparkHeight;            // If created, max height for a spark
+    int     Sparking;               // Probability of a spark each attempt
+    bool    bSerpentine;            // If serpentine, every other row of the panel is wired backwards
+
+    const uint16_t * pixelMap;      // Optional LED index for every cell, row by row from the top left
+
+    byte *  cells;                  // Height + 2 rows of Width cells, each with a zero byte either side
+    byte ** rows;                   // Height row pointers, counted from the top
+    byte *  spare;                  // Row that diffusion writes into before it is swapped in
+    byte *  zeroRow;                // Stands in for the rows below the bottom edge
+
+    unsigned long usLastFrame;
+
+    // when diffusing the fire upwards, these control how much to blend in from the cells below (ie: downward neighbors)
+    // BlendNeighbor1 is split evenly between the cell right below and the two diagonally below it, which is what spreads
+    // the flame sideways; these are FireEffect's weights
+
+    static const byte BlendSelf = 2;
+    static const byte BlendNeighbor1 = 3;
+    static const byte BlendNeighbor2 = 2;
+    static const byte BlendNeighbor3 = 1;
+    static const byte BlendTotal = (BlendSelf + BlendNeighbor1 + BlendNeighbor2 + BlendNeighbor3);
+    static const int  BlendShift = 3;
+
+    static_assert(BlendTotal == 1 << BlendShift, "DiffuseRow divides by BlendTotal with a shift; the weights must add up to 8");
+    static_assert(BlendNeighbor1 % 3 == 0, "BlendNeighbor1 is shared between three cells");
+
+    byte * Row(int y) const{
+
+        return y < Height ? rows[y] : zeroRow;
+    }
+
+    // Blends four cells at once.  The even and odd bytes of each word are split into 16-bit lanes,
+    // which can hold the whole weighted sum (at most 255 * BlendTotal) without spilling over.  The
+    // sum is divided with a shift: whatever the shift moves down out of the upper lane lands above
+    // the low byte of the lower one, where the mask drops it.
+
+    static uint32_t DiffuseLanes(uint32_t self, uint32_t belowLeft, uint32_t below1, uint32_t belowRight, uint32_t below2, uint32_t below3){
+
+        return self * BlendSelf +
+               (belowLeft + below1 + belowRight) * (BlendNeighbor1 / 3) +
+               below2 * BlendNeighbor2 +
+               below3 * BlendNeighbor3;
+    }
+
+    // Diffuses row y from itself and the three rows below it.  Rows are done top down, so the rows below are still
+    // last frame's, just as FireEffect works up the strip in place.
+
+    void DiffuseRow(int y){
+
+        const byte * self   = Row(y);
+        const byte * below1 = Row(y + 1);
+        const byte * below2 = Row(y + 2);
+        const byte * below3 = Row(y + 3);
+        const uint32_t mask = 0x00FF00FF;
+        int x = 0;
+
+        for (; x + 4 <= Width; x += 4){
+
+            uint32_t c, bl, b1, br, b2, b3;
+            memcpy(&c,  self + x,       4);
+            memcpy(&bl, below1 + x - 1, 4);             //  reads into the zero byte left of the row at x == 0
+            memcpy(&b1, below1 + x,     4);
+            memcpy(&br, below1 + x + 1, 4);             //  and right of the row on the last word
+            memcpy(&b2, below2 + x,     4);
+            memcpy(&b3, below3 + x,     4);
+
+            uint32_t even = DiffuseLanes(c & mask, bl & mask, b1 & mask, br & mask, b2 & mask, b3 & mask) >> BlendShift;
+            uint32_t odd  = DiffuseLanes((c >> 8) & mask, (bl >> 8) & mask, (b1 >> 8) & mask, (br >> 8) & mask, (b2 >> 8) & mask, (b3 >> 8) & mask) >> BlendShift;
+            uint32_t mix  = (even & mask) | ((odd & mask) << 8);
+
+            memcpy(spare + x, &mix, 4);
+        }
+
+        for (; x < Width; x++)
+            spare[x] = DiffuseLanes(self[x], below1[x - 1], below1[x], below1[x + 1], below2[x], below3[x]) >> BlendShift;
+
+        // The freshly diffused row takes this row's place, and the old one becomes the spare
+
+        byte * old = rows[y];
+        rows[y] = spare;
+        spare   = old;
+    }
+
+    uint16_t XY(int x, int y) const{
+
+        if (pixelMap)
+            return pixelMap[y * Width + x];
+
+        if (bSerpentine && (y & 1))
+            x = Width - 1 - x;
+
+        return y * Width + x;
+    }
+
+  public:
+
+    Fire2DEffect(int width, int height, int cooling = 20, int sparking = 100, int sparks = 3, int sparkHeight = 2, bool bserpentine = false, const uint16_t * pixelmap = nullptr)
+      : Width(width),
+        Height(height),
+        Cooling(cooling),
+        Sparks(sparks),
+        SparkHeight(min(sparkHeight, height)),          //  sparks land in the bottom SparkHeight rows, so no more than there are
+        Sparking(sparking),
+        bSerpentine(bserpentine),
+        pixelMap(pixelmap),
+        usLastFrame(0)
+
+    {
+        const int stride = width + 2;
+
+        cells = new byte[(height + 2) * stride] { 0 };
+        rows  = new byte * [height];
+
+        for (int y = 0; y < height; y++)
+            rows[y] = cells + y * stride + 1;
+
+        spare   = cells + height * stride + 1;
+        zeroRow = cells + (height + 1) * stride + 1;
+    }
+
+    virtual ~Fire2DEffect(){
+
+        delete [] rows;
+        delete [] cells;
+    }
+
+    virtual void DrawFire(CRGB * leds){
+
+        unsigned long usStart = micros();
+
+        // Cool each cell by a little bit
+
+        const uint8_t coolMax = min(255, ((Cooling * 10) / Height) + 2);
+        for (int y = 0; y < Height; y++){
+
+            byte * row = Row(y);
+            for (int x = 0; x < Width; x++)
+                row[x] = qsub8(row[x], random8(coolMax));
+        }
+
+        // Drift the heat up and diffuse it, top down, so every row still sees the undiffused rows below it
+
+        for (int y = 0; y < Height; y++)
+            DiffuseRow(y);
+
+        // Randomly ignite new sparks down in the flame core
+
+        int attempts = max(1, Sparks * Width / 8);
+        for (int i = 0; i < attempts; i++){
+
+            if (random8() < Sparking){
+
+                byte * row = Row(Height - 1 - random8(SparkHeight));
+                int x = random16(Width);
+                row[x] = qadd8(row[x], random8(160, 255));
+            }
+        }
+
+        // Finally convert heat to a color
+
+        for (int y = 0; y < Height; y++){
+
+            const byte * row = Row(y);
+            for (int x = 0; x < Width; x++)
+                leds[XY(x, y)] = HeatColor(row[x]);
+        }
+
+        usLastFrame = micros() - usStart;
+    }
+
+    unsigned long LastFrameMicros() const{
+
+        return usLastFrame;
+    }
+};
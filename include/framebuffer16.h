@@ -0,0 +1,180 @@
+//+--------------------------------------------------------------------------
+//
+// File:        framebuffer16.h
+//
+// Description:
+//
+//      Optional high precision render path.  Effects draw and fade in 16 bits
+//      per channel, and a single output pass does brightness, gamma and
+//      temporal dithering down to CRGB, so long fades keep their smoothness
+//      instead of banding and sticking at the bottom of the 8-bit range.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+#include <math.h>
+
+struct CRGB16
+{
+  uint16_t r;
+  uint16_t g;
+  uint16_t b;
+};
+
+class HighPrecisionBuffer
+{
+  protected:
+
+    size_t          _cLength;
+    CRGB16 *        _pixels;
+    uint8_t *       _residual;              //  Per channel rounding error carried into the next frame
+    uint32_t        _gamma[257];            //  Gamma curve in 8.16 fixed point, one entry per 256 steps of 16-bit input
+    unsigned long   _usLastQuantize;
+
+    // Scales an 8-bit color channel up to 16 bits and by a 0-256 amount
+
+    static uint32_t Expand(uint8_t value, uint16_t amount)
+    {
+      return ((uint32_t) value * 257 * amount) >> 8;
+    }
+
+    static void AddChannel(uint16_t & channel, uint32_t value)
+    {
+      channel = min(65535UL, (unsigned long)(channel + value));
+    }
+
+  public:
+
+    HighPrecisionBuffer(size_t cLength, float gamma = 1.0f)
+      : _cLength(cLength),
+        _usLastQuantize(0)
+    {
+      _pixels   = new CRGB16[cLength];
+      _residual = new uint8_t[cLength * 3] { 0 };
+      Clear();
+
+      // Entry i is the light for a 16-bit input of i * 256, so it is indexed by value >> 8.  The
+      // last entry sits just past full scale and is only ever interpolated towards, never reached.
+
+      for (int i = 0; i <= 256; i++)
+        _gamma[i] = (uint32_t)(pow(i * 256.0 / 65535.0, gamma) * (255 << 16) + 0.5);
+    }
+
+    virtual ~HighPrecisionBuffer()
+    {
+      delete [] _pixels;
+      delete [] _residual;
+    }
+
+    size_t Count() const
+    {
+      return _cLength;
+    }
+
+    void Clear()
+    {
+      memset((void *) _pixels, 0, _cLength * sizeof(CRGB16));
+    }
+
+    // FadeToBlackBy
+    //
+    // Same meaning of fadeBy as CRGB::fadeToBlackBy, but the product keeps 16 bits so a dim tail
+    // keeps getting dimmer instead of rounding to the same value or straight to zero
+
+    void FadeToBlackBy(uint8_t fadeBy)
+    {
+      uint16_t * p = &_pixels[0].r;
+      const uint32_t keep = 256 - fadeBy;
+
+      for (size_t i = 0; i < _cLength * 3; i++)
+        p[i] = (p[i] * keep) >> 8;
+    }
+
+    void SetPixel(size_t i, CRGB color)
+    {
+      _pixels[i].r = color.r * 257;
+      _pixels[i].g = color.g * 257;
+      _pixels[i].b = color.b * 257;
+    }
+
+    // AddPixel
+    //
+    // Adds amount/256 of a color, saturating at full
+
+    void AddPixel(size_t i, CRGB color, uint16_t amount = 256)
+    {
+      AddChannel(_pixels[i].r, Expand(color.r, amount));
+      AddChannel(_pixels[i].g, Expand(color.g, amount));
+      AddChannel(_pixels[i].b, Expand(color.b, amount));
+    }
+
+    // DrawPixels
+    //
+    // Just like DrawPixels in ledgfx.h, but the partial pixels at either end keep their exact
+    // fraction rather than going through an 8-bit ColorFraction
+
+    void DrawPixels(float fPos, float count, CRGB color)
+    {
+      float availFirstPixel = 1.0f - (fPos - (long)(fPos));
+      float amtFirstPixel = min(availFirstPixel, count);
+      float remaining = min(count, _cLength - fPos);
+      int iPos = fPos;
+
+      if (remaining > 0.0f)
+      {
+        AddPixel(iPos++, color, amtFirstPixel * 256);
+        remaining -= amtFirstPixel;
+      }
+
+      while (remaining > 1.0f)
+      {
+        AddPixel(iPos++, color);
+        remaining--;
+      }
+
+      if (remaining > 0.0f)
+        AddPixel(iPos, color, remaining * 256);
+    }
+
+    // Quantize
+    //
+    // The output pass.  Every channel is scaled by brightness, run through the interpolated gamma
+    // curve and rounded to 8 bits with the previous frame's rounding error added back in, so over
+    // a few frames a pixel averages out to its exact 16-bit value.  Integer only, no branches.
+
+    void Quantize(CRGB * out, uint8_t brightness = 255)
+    {
+      unsigned long usStart = micros();
+
+      const uint16_t * pIn  = &_pixels[0].r;
+      uint8_t *        pOut = (uint8_t *) out;
+      const uint32_t   scale = brightness + 1;
+
+      for (size_t i = 0; i < _cLength * 3; i++)
+      {
+        uint32_t value = (pIn[i] * scale + 0x80) >> 8;
+        uint32_t index = value >> 8;
+        uint32_t curve = _gamma[index] + (((_gamma[index + 1] - _gamma[index]) * (value & 0xFF)) >> 8);
+        uint32_t light = (curve + 0x80) >> 8;                               //  8.8, 255.0 at full scale
+
+        uint32_t dithered = light + _residual[i];
+        uint32_t quantized = dithered >> 8;
+
+        pOut[i]      = quantized - (quantized >> 8);                        //  256 only happens at full scale; clamp it
+        _residual[i] = dithered & 0xFF;
+      }
+
+      _usLastQuantize = micros() - usStart;
+    }
+
+    unsigned long LastQuantizeMicros() const
+    {
+      return _usLastQuantize;
+    }
+};
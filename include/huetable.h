@@ -0,0 +1,65 @@
+//+--------------------------------------------------------------------------
+//
+// File:        huetable.h
+//
+// Description:
+//
+//      Precomputed hue wheels for the rainbow effects.  A HueTable holds the
+//      256 colors of FastLED's rainbow at one saturation and value, so
+//      getting a hue is an array lookup instead of an HSV to RGB conversion,
+//      and fill_hue_gradient is a plain indexed copy out of the table.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+
+class HueTable
+{
+  protected:
+
+    CRGB    _colors[256];
+
+  public:
+
+    HueTable(uint8_t sat = 255, uint8_t val = 255)
+    {
+        Build(sat, val);
+    }
+
+    // Build
+    //
+    // Fills the wheel with hsv2rgb_rainbow, the same conversion setHue and CHSV use, so a table
+    // color is identical to converting on the fly
+
+    void Build(uint8_t sat, uint8_t val)
+    {
+        for (int hue = 0; hue < 256; hue++)
+            hsv2rgb_rainbow(CHSV(hue, sat, val), _colors[hue]);
+    }
+
+    const CRGB & operator[](uint8_t hue) const
+    {
+        return _colors[hue];
+    }
+};
+
+static const HueTable RainbowHues;                      //  Full saturation and brightness, as CRGB::setHue
+
+// fill_hue_gradient
+//
+// fill_rainbow out of a table: startHue at the first pixel, stepping deltaHue per pixel.  With
+// RainbowHues the colors are setHue's, at full saturation; fill_rainbow itself uses saturation
+// 240, so pass a HueTable(240) to match it exactly.
+
+void fill_hue_gradient(CRGB * leds, int count, uint8_t startHue, uint8_t deltaHue, const HueTable & table = RainbowHues)
+{
+    uint8_t hue = startHue;
+    for (int i = 0; i < count; i++, hue += deltaHue)
+        leds[i] = table[hue];
+}
@@ -0,0 +1,259 @@
+//+--------------------------------------------------------------------------
+//
+// File:        layout.h
+//
+// Description:
+//
+//      Physical LED positions for fans, rings, strips and matrices.  Loads a
+//      compact coordinate table once and precomputes, per axis, a normalized
+//      0-255 coordinate for every pixel and the pixel order along that axis,
+//      so spatial effects are a single indexed pass per frame.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+#include <algorithm>
+#include <math.h>
+
+#include "ledgfx.h"
+
+// One entry of a layout table: position in a -128 to 127 cube, three bytes per LED
+
+struct LedCoord
+{
+  int8_t x;
+  int8_t y;
+  int8_t z;
+};
+
+enum LayoutAxis
+{
+  AxisX       = 0,
+  AxisY       = 1,
+  AxisZ       = 2,
+  AxisRadial  = 3,              //  Distance from the center of the layout's bounding box
+  AxisCount   = 4
+};
+
+// MakeStripCoords
+//
+// A straight strip laid out along the X axis
+
+inline void MakeStripCoords(LedCoord * coords, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    coords[i].x = (count > 1) ? (int8_t)(-127 + (int)(i * 254 / (count - 1))) : 0;
+    coords[i].y = 0;
+    coords[i].z = 0;
+  }
+}
+
+// MakeRingCoords
+//
+// A ring or fan of LEDs, counter-clockwise from startAngle (0-255 is one full turn).  A fan with
+// LED 0 sitting LED_FAN_OFFSET pixels around from the right is
+// MakeRingCoords(coords, FAN_SIZE, LED_FAN_OFFSET * 256 / FAN_SIZE).
+
+inline void MakeRingCoords(LedCoord * coords, size_t count, uint8_t startAngle = 0)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    uint8_t angle = startAngle + (uint8_t)(i * 256 / count);
+    coords[i].x = (int8_t)(cos8(angle) - 128);
+    coords[i].y = (int8_t)(sin8(angle) - 128);
+    coords[i].z = 0;
+  }
+}
+
+// MakeMatrixCoords
+//
+// A width x height panel wired row by row from the top left.  Serpentine panels run every other
+// row backwards.
+
+inline void MakeMatrixCoords(LedCoord * coords, size_t width, size_t height, bool bSerpentine = false)
+{
+  for (size_t i = 0; i < width * height; i++)
+  {
+    size_t row = i / width;
+    size_t col = i % width;
+    if (bSerpentine && (row & 1))
+      col = width - 1 - col;
+
+    coords[i].x = (width  > 1) ? (int8_t)(-127 + (int)(col * 254 / (width  - 1))) : 0;
+    coords[i].y = (height > 1) ? (int8_t)( 127 - (int)(row * 254 / (height - 1))) : 0;
+    coords[i].z = 0;
+  }
+}
+
+class LedLayout
+{
+  protected:
+
+    size_t      _cLength;
+    uint8_t *   _coords[AxisCount];         //  Normalized 0-255 position of each pixel along each axis
+    uint16_t *  _order[AxisCount];          //  Pixel indices sorted along each axis
+
+    static float Radius(const LedCoord & coord, const int lo[3], const int hi[3])
+    {
+      float dx = coord.x - (lo[0] + hi[0]) / 2.0f;
+      float dy = coord.y - (lo[1] + hi[1]) / 2.0f;
+      float dz = coord.z - (lo[2] + hi[2]) / 2.0f;
+      return sqrtf(dx * dx + dy * dy + dz * dz);
+    }
+
+  public:
+
+    LedLayout(size_t cLength)
+      : _cLength(cLength)
+    {
+      for (int axis = 0; axis < AxisCount; axis++)
+      {
+        _coords[axis] = new uint8_t[cLength] { 0 };
+        _order[axis]  = new uint16_t[cLength];
+        for (size_t i = 0; i < cLength; i++)
+          _order[axis][i] = i;
+      }
+    }
+
+    virtual ~LedLayout()
+    {
+      for (int axis = 0; axis < AxisCount; axis++)
+      {
+        delete [] _coords[axis];
+        delete [] _order[axis];
+      }
+    }
+
+    // Load
+    //
+    // Takes a coordinate table with one entry per pixel and does all of the expensive work up
+    // front: stretching each axis to 0-255, measuring distance from the center, and sorting.
+
+    void Load(const LedCoord * table)
+    {
+      int lo[3] = {  127,  127,  127 };
+      int hi[3] = { -128, -128, -128 };
+
+      for (size_t i = 0; i < _cLength; i++)
+      {
+        const int8_t c[3] = { table[i].x, table[i].y, table[i].z };
+        for (int axis = 0; axis < 3; axis++)
+        {
+          lo[axis] = min(lo[axis], (int) c[axis]);
+          hi[axis] = max(hi[axis], (int) c[axis]);
+        }
+      }
+
+      // Distance from the center of the bounding box, in two passes so no scratch buffer is
+      // needed for big layouts
+
+      float maxRadius = 0.0f;
+      for (size_t i = 0; i < _cLength; i++)
+        maxRadius = max(maxRadius, Radius(table[i], lo, hi));
+
+      for (size_t i = 0; i < _cLength; i++)
+      {
+        const int8_t c[3] = { table[i].x, table[i].y, table[i].z };
+        for (int axis = 0; axis < 3; axis++)
+        {
+          int span = hi[axis] - lo[axis];
+          _coords[axis][i] = span ? (c[axis] - lo[axis]) * 255 / span : 0;
+        }
+
+        _coords[AxisRadial][i] = maxRadius > 0.0f ? (uint8_t)(Radius(table[i], lo, hi) * 255.0f / maxRadius) : 0;
+      }
+
+      // Ties keep strip order so the projections are stable from one boot to the next
+
+      for (int axis = 0; axis < AxisCount; axis++)
+      {
+        const uint8_t * coords = _coords[axis];
+        for (size_t i = 0; i < _cLength; i++)
+          _order[axis][i] = i;
+
+        std::sort(_order[axis], _order[axis] + _cLength, [coords](uint16_t a, uint16_t b)
+        {
+          return coords[a] != coords[b] ? coords[a] < coords[b] : a < b;
+        });
+      }
+    }
+
+    size_t Count() const
+    {
+      return _cLength;
+    }
+
+    const uint8_t * Coords(LayoutAxis axis) const
+    {
+      return _coords[axis];
+    }
+
+    // FirstAtOrAbove
+    //
+    // Position along an axis of the first pixel whose coordinate is at least 'coord', or Count()
+    // if there is none; a binary search over the sorted order
+
+    size_t FirstAtOrAbove(LayoutAxis axis, uint8_t coord) const
+    {
+      const uint8_t * coords = _coords[axis];
+      return std::lower_bound(_order[axis], _order[axis] + _cLength, coord, [coords](uint16_t i, uint8_t value)
+      {
+        return coords[i] < value;
+      }) - _order[axis];
+    }
+
+    // PixelAt
+    //
+    // Strip position of the iPos'th pixel along an axis, like the 3rd pixel from the top when
+    // bReverse is set on the Y axis
+
+    uint16_t PixelAt(LayoutAxis axis, size_t iPos, bool bReverse = false) const
+    {
+      return _order[axis][bReverse ? _cLength - 1 - iPos : iPos];
+    }
+};
+
+// DrawLayoutPixels
+//
+// Just like DrawPixels but the position counts pixels along an axis of the layout rather than
+// along the strip.  This is DrawFanPixels for any shape.
+
+void DrawLayoutPixels(const LedLayout & layout, LayoutAxis axis, float fPos, float count, CRGB color, bool bReverse = false)
+{
+  // Calculate how much the first pixel will hold
+
+  float availFirstPixel = 1.0f - (fPos - (long)(fPos));
+  float amtFirstPixel = min(availFirstPixel, count);
+  float remaining = min(count, layout.Count()-fPos);
+  int iPos = fPos;
+
+  // Blend (add) in the color of the first partial pixel
+
+  if (remaining > 0.0f)
+  {
+    FastLED.leds()[layout.PixelAt(axis, iPos++, bReverse)] += ColorFraction(color, amtFirstPixel);
+    remaining -= amtFirstPixel;
+  }
+
+  // Now draw any full pixels in the middle
+
+  while (remaining > 1.0f)
+  {
+    FastLED.leds()[layout.PixelAt(axis, iPos++, bReverse)] += color;
+    remaining--;
+  }
+
+  // Draw tail pixel, up to a single full pixel
+
+  if (remaining > 0.0f)
+  {
+    FastLED.leds()[layout.PixelAt(axis, iPos, bReverse)] += ColorFraction(color, remaining);
+  }
+}
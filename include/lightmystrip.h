@@ -21,6 +21,5 @@ void UkrainFlag(){
   for (int j = UK_LEDS; j < NUM_LEDS; j++){
     h_LEDs[j] = CRGB::Blue;
   }
-  FastLED.show(h_Brightness);
 
 };
\ No newline at end of file
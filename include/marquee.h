@@ -16,18 +16,15 @@
 #define FASTLED_INTERNAL
 #include <FastLED.h>
 #include "ledgfx.h"
+#include "huetable.h"
 
 void DrawMarquee(){
     
     static byte j = HUE_BLUE;
     j += 4;
-    byte k = j;
 
-    // Roughly equivalent to fill_rainbow(h_LEDs, NUM_LEDS, j, 8);
-
-    CRGB c;
-    for (int i = 0; i < NUM_LEDS; i ++)
-        h_LEDs[i] = c.setHue(k+=8);
+    // setHue on every LED, eight hues apart, but copied out of the hue table
+    fill_hue_gradient(h_LEDs, NUM_LEDS, j + 8, 8);
 
     static int scroll = 0;
     scroll++;
@@ -36,7 +33,6 @@ void DrawMarquee(){
     {
         h_LEDs[i] = CRGB::Black;
     }
-    delay(50);
 }
 
 void DrawMarqueeComparison(){
@@ -0,0 +1,92 @@
+//+--------------------------------------------------------------------------
+//
+// File:        showconfig.h
+//
+// Description:
+//
+//      Keeps the running show in flash so the strip comes back up where it
+//      was left after a reset or power cut: the selected effect, the
+//      transition style, the value of every automatable parameter and the
+//      timelines animating them.  Stored as a versioned blob and the
+//      timelines next to it in NVS through Preferences.
+//
+// History:     Oct-19-2026     tomwer      Created
+//                              tomwer      Timelines saved with the show
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+#include <Preferences.h>
+
+#include "automation.h"
+
+#define SHOW_CONFIG_NAMESPACE   "ledshow"
+#define SHOW_CONFIG_KEY         "show"
+#define SHOW_TIMELINE_KEY       "timelines"
+#define SHOW_CONFIG_VERSION     2
+
+struct ShowConfig
+{
+  uint8_t   version;
+  char      effect;                                 //  Key of the selected effect, 0 for none
+  uint8_t   transition;                             //  TransitionStyle for the next switch
+  uint8_t   paramCount;
+  uint32_t  schema;                                 //  ParameterAutomation::SchemaHash when saved
+  int32_t   params[AUTOMATION_MAX_PARAMS];          //  16.16, see ParameterAutomation::Snapshot
+  uint16_t  timelineBytes;                          //  Length of the timelines saved with it, 0 for none
+};
+
+class ShowStore
+{
+  protected:
+
+    Preferences _prefs;
+
+  public:
+
+    // Load
+    //
+    // False if nothing has been saved yet or it was saved by a different version.  pTimelines has
+    // room for AUTOMATION_TIMELINE_BYTES and gets config.timelineBytes of what
+    // ParameterAutomation::SaveTimelines wrote; if they can't be read, timelineBytes comes back 0.
+
+    bool Load(ShowConfig & config, uint8_t * pTimelines)
+    {
+      if (!_prefs.begin(SHOW_CONFIG_NAMESPACE, true))
+        return false;
+
+      size_t length = _prefs.getBytes(SHOW_CONFIG_KEY, &config, sizeof(config));
+      bool   bValid = length == sizeof(config) && config.version == SHOW_CONFIG_VERSION;
+
+      if (bValid && config.timelineBytes)
+        if (config.timelineBytes > AUTOMATION_TIMELINE_BYTES || _prefs.getBytes(SHOW_TIMELINE_KEY, pTimelines, config.timelineBytes) != config.timelineBytes)
+          config.timelineBytes = 0;
+
+      _prefs.end();
+      return bValid;
+    }
+
+    bool Save(ShowConfig & config, const uint8_t * pTimelines)
+    {
+      config.version = SHOW_CONFIG_VERSION;
+
+      if (!_prefs.begin(SHOW_CONFIG_NAMESPACE, false))
+        return false;
+
+      // Timelines first, so a config is only written once the timelines it counts are there; a
+      // stale count from an older config fails the length check in Load rather than misreading
+
+      bool bSaved = true;
+      if (config.timelineBytes)
+        bSaved = _prefs.putBytes(SHOW_TIMELINE_KEY, pTimelines, config.timelineBytes) == config.timelineBytes;
+      else
+        _prefs.remove(SHOW_TIMELINE_KEY);
+
+      bSaved = bSaved && _prefs.putBytes(SHOW_CONFIG_KEY, &config, sizeof(config)) == sizeof(config);
+      _prefs.end();
+
+      return bSaved;
+    }
+};
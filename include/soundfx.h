@@ -0,0 +1,67 @@
+//+--------------------------------------------------------------------------
+//
+// File:        soundfx.h
+//
+// Description:
+//
+//      Audio reactive effects driven by the features from audio.h
+//
+// History:     Oct-19-2026     tomwer      Created
+//                              tomwer      Spectrum bands cover the whole strip
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+
+#include "ledgfx.h"
+#include "audio.h"
+
+extern CRGB h_LEDs[];
+
+// DrawVUMeter
+//
+// Classic bar graph: the strip fills up green through yellow to red with the level, and a peak
+// pixel sticks at the highest point for a moment before dropping back down.
+
+void DrawVUMeter(const AudioFeatures & features){
+
+    static const CRGBPalette16 vuPalette = vu_gpGreen;
+    static int peak = 0;
+
+    int lit = features.Level * NUM_LEDS / 255;
+
+    FastLED.clear();
+    for (int i = 0; i < lit; i++)
+        h_LEDs[i] = ColorFromPalette(vuPalette, i * 255 / NUM_LEDS);
+
+    // Drop the peak a pixel every fifth frame, which is every 50 ms at the VU meter's frame interval
+    static uint8_t frame = 0;
+    if (++frame % 5 == 0 && peak > 0)
+        peak--;
+    peak = max(peak, lit);
+
+    if (peak > 0)
+        h_LEDs[peak - 1] = CRGB::White;
+}
+
+// DrawSpectrum
+//
+// Splits the strip into one segment per band, bass at pixel 0, each lit in its own hue with the
+// band's energy as brightness.  Band b covers b * NUM_LEDS / AUDIO_BANDS up to where the next one
+// starts, so when the strip doesn't divide evenly the odd pixels are spread along it rather than
+// left dark at the end.
+
+void DrawSpectrum(const AudioFeatures & features){
+
+    FastLED.clear();
+    for (int b = 0; b < AUDIO_BANDS; b++){
+
+        CRGB color = CHSV(b * (256 / AUDIO_BANDS), 255, features.Bands[b]);
+        for (int i = b * NUM_LEDS / AUDIO_BANDS; i < (b + 1) * NUM_LEDS / AUDIO_BANDS; i++)
+            h_LEDs[i] = color;
+    }
+}
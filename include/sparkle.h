@@ -0,0 +1,155 @@
+//+--------------------------------------------------------------------------
+//
+// File:        sparkle.h
+//
+// Description:
+//
+//      Twinkle engine: every pixel has its own fade envelope, so sparkles
+//      swell up and die away on their own instead of the strip being
+//      cleared in one go.  Each pixel has two bytes of state, kept in two
+//      arrays so the phases pack four to a word, and all the envelopes
+//      advance in one pass over the words with no branches, so thousands of
+//      sparkles cost the same as a few.
+//
+//        phase       0-255 through the envelope, 0 when the pixel is dark
+//        style       bits 0-2 rate, how fast the phase moves; bits 3-7
+//                    color, an index into the engine's colors
+//
+// History:     Oct-19-2026     tomwer      Created
+//                              tomwer      Phases in 8-bit lanes, four to a word
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+
+class TwinkleEngine
+{
+  protected:
+
+    size_t          _count;
+    size_t          _words;
+    uint32_t *      _phaseWords;        //  Four pixels to a word, padded to a whole number of words
+    uint32_t *      _styleWords;        //  Likewise
+    uint8_t *       _phase;             //  The same, a pixel at a time
+    uint8_t *       _style;
+    const CRGB *    _colors;
+    uint8_t         _colorCount;
+    uint8_t         _minRate;
+    uint8_t         _maxRate;
+    uint8_t         _envelope[256];     //  Brightness at each phase: a quick rise, then a long fall
+    unsigned long   _usLastFrame;
+
+  public:
+
+    // TwinkleEngine
+    //
+    // Up to 32 colors; rates run from 0 (about 128 frames a sparkle) to 7 (16 frames)
+
+    TwinkleEngine(size_t count, const CRGB * colors, uint8_t colorCount, uint8_t minRate = 0, uint8_t maxRate = 7)
+      : _count(count),
+        _words((count + 3) / 4),
+        _colors(colors),
+        _colorCount(min(colorCount, (uint8_t) 32)),
+        _minRate(min(minRate, (uint8_t) 7)),
+        _maxRate(min(max(minRate, maxRate), (uint8_t) 7)),
+        _usLastFrame(0)
+    {
+        _phaseWords = new uint32_t[_words] { 0 };
+        _styleWords = new uint32_t[_words] { 0 };
+        _phase      = (uint8_t *) _phaseWords;
+        _style      = (uint8_t *) _styleWords;
+
+        for (int phase = 0; phase < 256; phase++)
+        {
+            int level = phase < 64 ? phase * 4 : (255 - phase) * 4 / 3;
+            _envelope[phase] = (level * level + 255) >> 8;                //  squared, so the tail fades out smoothly to the eye
+        }
+    }
+
+    virtual ~TwinkleEngine()
+    {
+        delete [] _phaseWords;
+        delete [] _styleWords;
+    }
+
+    // Spawn
+    //
+    // Starts up to 'sparkles' new sparkles on random dark pixels; one that lands on a pixel that is
+    // already lit is skipped rather than restarting it.  Strips longer than random16 reaches take two draws.
+
+    void Spawn(int sparkles)
+    {
+        for (int i = 0; i < sparkles; i++)
+        {
+            size_t pixel = _count > 0xFFFF ? (((uint32_t) random16() << 16) | random16()) % _count : random16(_count);
+            if (_phase[pixel])
+                continue;
+
+            uint8_t rate  = random8(_minRate, _maxRate + 1);
+            uint8_t color = random8(_colorCount);
+            _style[pixel] = (color << 3) | rate;
+            _phase[pixel] = 1;
+        }
+    }
+
+    // Advance
+    //
+    // Moves every envelope along by (rate + 1) * 2, four pixels to a word in 8-bit lanes.  The low
+    // seven bits of each lane are added on their own so nothing carries into the next lane; a lane
+    // whose top bit was set and gets set again by that carry has run past 255, which is how a
+    // finished sparkle finds out to go dark.
+
+    void Advance()
+    {
+        for (size_t w = 0; w < _words; w++)
+        {
+            uint32_t phase = _phaseWords[w];
+            uint32_t style = _styleWords[w];
+
+            uint32_t live  = (((((phase & 0x7F7F7F7F) + 0x7F7F7F7F) | phase) >> 7) & 0x01010101) * 0xFF;    //  all ones in lanes with a running envelope
+            uint32_t step  = (((style & 0x07070707) + 0x01010101) << 1) & live;                            //  at most 16, so the top bit stays clear
+
+            uint32_t low   = (phase & 0x7F7F7F7F) + step;
+            uint32_t done  = (((phase & low) >> 7) & 0x01010101) * 0xFF;                                  //  lanes that just finished
+
+            phase = (low ^ (phase & 0x80808080)) & ~done;
+            style &= ~done;
+
+            _phaseWords[w] = phase;
+            _styleWords[w] = style;
+        }
+    }
+
+    // Draw
+    //
+    // Every pixel is its color scaled by its envelope, which is 0 for a dark pixel
+
+    void Draw(CRGB * leds) const
+    {
+        for (size_t i = 0; i < _count; i++)
+        {
+            CRGB color = _colors[(_style[i] >> 3) % _colorCount];
+            leds[i] = color.nscale8(_envelope[_phase[i]]);
+        }
+    }
+
+    void DrawFrame(CRGB * leds, int sparkles)
+    {
+        unsigned long usStart = micros();
+
+        Spawn(sparkles);
+        Advance();
+        Draw(leds);
+
+        _usLastFrame = micros() - usStart;
+    }
+
+    unsigned long LastFrameMicros() const
+    {
+        return _usLastFrame;
+    }
+};
@@ -0,0 +1,63 @@
+//+--------------------------------------------------------------------------
+//
+// File:        spatialfx.h
+//
+// Description:
+//
+//      Effects that work in physical space rather than strip order, using the
+//      precomputed coordinates from layout.h
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+
+#include "layout.h"
+
+extern CRGB h_LEDs[];
+
+// DrawPlaneSweep
+//
+// A soft-edged plane swings back and forth along one axis, lighting every pixel it passes
+// through regardless of how the strip is wired.  Only the pixels near the plane are lit, so
+// rather than measuring every pixel's distance it blacks the frame out and walks the layout's
+// sorted order from the first pixel inside the plane's reach to the last.
+
+void DrawPlaneSweep(const LedLayout & layout, LayoutAxis axis, CRGB color, uint8_t width = 32){
+
+    const uint8_t * coords = layout.Coords(axis);
+    const uint16_t  falloff = 256 / max((uint8_t) 1, width);
+    const uint8_t   reach = 254 / falloff;                          //  furthest a pixel can be from the plane and still be lit
+    uint8_t plane = beatsin8(20);
+
+    fill_solid(h_LEDs, layout.Count(), CRGB::Black);
+
+    for (size_t iPos = layout.FirstAtOrAbove(axis, plane > reach ? plane - reach : 0); iPos < layout.Count(); iPos++){
+
+        uint16_t i = layout.PixelAt(axis, iPos);
+        if (coords[i] > plane + reach)
+            break;
+
+        uint16_t fade = abs(coords[i] - plane) * falloff;
+        h_LEDs[i] = CRGB(color).nscale8_video(255 - fade);
+    }
+}
+
+// DrawRadialWave
+//
+// Rainbow rings that ripple outwards from the center of the layout
+
+void DrawRadialWave(const LedLayout & layout){
+
+    const uint8_t * radius = layout.Coords(AxisRadial);
+    static uint8_t phase = 0;
+    phase += 4;
+
+    for (size_t i = 0; i < layout.Count(); i++)
+        h_LEDs[i] = CHSV(radius[i] - phase, 255, sin8(radius[i] * 2 - phase * 2));
+}
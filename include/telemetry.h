@@ -0,0 +1,169 @@
+//+--------------------------------------------------------------------------
+//
+// File:        telemetry.h
+//
+// Description:
+//
+//      Binary frame statistics for long soak runs.  A fixed size record is
+//      packed into a preallocated byte ring every telemetry period, and the
+//      ring is drained only as fast as the port can take it without
+//      blocking, so a slow or absent listener costs the render loop nothing
+//      but dropped records.  tools/telemetry_csv.py turns a capture back
+//      into CSV.
+//
+//      Records only ever go out whole, so text printed to the same port
+//      lands between two of them, where the decoder finds the next sync,
+//      skips the text and counts what it skipped.
+//
+//      Record layout, little endian, TELEMETRY_VERSION 1:
+//
+//        0   u8[2]   sync, A5 5A
+//        2   u8      version
+//        3   u8      length of the whole record
+//        4   u16     sequence number
+//        6   u32     ms since boot
+//        10  u32     us to draw the last effect frame
+//        14  u32     us for the last FastLED.show()
+//        18  u16     frames per second
+//        20  u32     unscaled power estimate, mW
+//        24  u8      brightness after power throttling
+//        25  u16     power checks that found the strip throttled, since boot
+//        27  u32     free heap, bytes
+//        31  char    key of the active effect, 0 for none
+//        32  u16     records dropped because the ring was full, since boot
+//        34  u8      checksum, XOR of every byte before it
+//
+// History:     Oct-19-2026     tomwer      Created
+//                              tomwer      Whole records per drain
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+#include <string.h>
+
+#define TELEMETRY_VERSION       1
+#define TELEMETRY_RING_SIZE     1024        //  Bytes; must be a power of two
+#define TELEMETRY_SYNC0         0xA5
+#define TELEMETRY_SYNC1         0x5A
+
+struct __attribute__((packed)) TelemetryRecord
+{
+  uint8_t   sync[2];
+  uint8_t   version;
+  uint8_t   length;
+  uint16_t  sequence;
+  uint32_t  msUptime;
+  uint32_t  usFrame;
+  uint32_t  usShow;
+  uint16_t  fps;
+  uint32_t  powerMilliwatts;
+  uint8_t   brightness;
+  uint16_t  throttleEvents;
+  uint32_t  freeHeap;
+  char      effect;
+  uint16_t  dropped;
+  uint8_t   checksum;
+};
+
+class TelemetryStream
+{
+  protected:
+
+    uint8_t * _ring;
+    size_t    _head;                    //  Next byte to write; free running, masked on use
+    size_t    _tail;                    //  Next byte to send
+    uint16_t  _sequence;
+    uint16_t  _dropped;
+    size_t    _sentOfRecord;            //  Bytes of the record at _tail a short write left sent
+
+  public:
+
+    TelemetryStream()
+      : _head(0),
+        _tail(0),
+        _sequence(0),
+        _dropped(0),
+        _sentOfRecord(0)
+    {
+        _ring = new uint8_t[TELEMETRY_RING_SIZE] { 0 };
+    }
+
+    virtual ~TelemetryStream()
+    {
+        delete [] _ring;
+    }
+
+    // Record
+    //
+    // Stamps the header, sequence and checksum on a record and queues it.  If the ring can't take
+    // the whole record it is dropped and counted rather than overwriting one half sent.
+
+    bool Record(TelemetryRecord & record)
+    {
+        record.sync[0]  = TELEMETRY_SYNC0;
+        record.sync[1]  = TELEMETRY_SYNC1;
+        record.version  = TELEMETRY_VERSION;
+        record.length   = sizeof(TelemetryRecord);
+        record.sequence = _sequence++;
+        record.dropped  = _dropped;
+
+        const uint8_t * bytes = (const uint8_t *) &record;
+        uint8_t checksum = 0;
+        for (size_t i = 0; i < sizeof(TelemetryRecord) - 1; i++)
+            checksum ^= bytes[i];
+        record.checksum = checksum;
+
+        if (TELEMETRY_RING_SIZE - (_head - _tail) < sizeof(TelemetryRecord))
+        {
+            _dropped++;
+            return false;
+        }
+
+        for (size_t i = 0; i < sizeof(TelemetryRecord); i++)
+            _ring[(_head + i) & (TELEMETRY_RING_SIZE - 1)] = bytes[i];
+        _head += sizeof(TelemetryRecord);
+        return true;
+    }
+
+    // Drain
+    //
+    // Sends as many whole records as fit in 'budget' bytes, in at most two writes (the ring may
+    // wrap), so the caller decides how much the port can take without blocking.  A port that
+    // takes less than it was offered splits a record anyway; the rest of it goes first next time.
+
+    size_t Drain(Print & out, size_t budget)
+    {
+        const size_t rest = (sizeof(TelemetryRecord) - _sentOfRecord) % sizeof(TelemetryRecord);
+        if (budget > rest)
+            budget = rest + (budget - rest) / sizeof(TelemetryRecord) * sizeof(TelemetryRecord);
+
+        size_t sent = 0;
+
+        while (sent < budget && _tail != _head)
+        {
+            size_t offset = _tail & (TELEMETRY_RING_SIZE - 1);
+            size_t count  = min(min(_head - _tail, TELEMETRY_RING_SIZE - offset), budget - sent);
+            size_t written = out.write(_ring + offset, count);
+
+            _tail += written;
+            sent  += written;
+            if (written < count)
+                break;
+        }
+
+        _sentOfRecord = (_sentOfRecord + sent) % sizeof(TelemetryRecord);
+        return sent;
+    }
+
+    size_t Pending() const
+    {
+        return _head - _tail;
+    }
+
+    uint16_t Dropped() const
+    {
+        return _dropped;
+    }
+};
@@ -0,0 +1,364 @@
+//+--------------------------------------------------------------------------
+//
+// File:        timerwheel.h
+//
+// Description:
+//
+//      Hierarchical timer wheel with 1 ms ticks.  Every periodic job in the
+//      sketch registers a WheelTimer here instead of keeping its own static
+//      and polling millis().  Adding, removing and firing a timer is O(1)
+//      however many are registered, periodic timers are rescheduled from
+//      their deadline rather than from when they ran so they never drift,
+//      and NextDeadline() says how long the loop may sleep.
+//
+//      Level 0 has 256 one millisecond slots, levels 1 to 3 have 64 slots
+//      each covering 256 ms, 16 s and 17 minutes, for about 18 hours in all.
+//      Longer timers park in the last slot and are re-filed when they come
+//      around.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+
+#define WHEEL_LEVELS        4
+#define WHEEL_ROOT_BITS     8                               //  256 slots in level 0
+#define WHEEL_LEVEL_BITS    6                               //  64 slots in each of the others
+#define WHEEL_NO_DEADLINE   0xFFFFFFFFUL
+
+typedef void (*TimerFunc)(void * pContext);
+
+struct WheelTimer
+{
+  WheelTimer *  pNext;
+  WheelTimer *  pPrev;
+  WheelTimer *  pSlot;                                      //  Head of the slot list the timer is filed in
+  uint32_t      msExpires;
+  uint32_t      msPeriod;                                   //  0 for a one-shot timer
+  TimerFunc     callback;
+  void *        pContext;
+  bool          bArmed;
+
+  WheelTimer(TimerFunc func = nullptr, void * context = nullptr)
+    : pNext(nullptr), pPrev(nullptr), pSlot(nullptr), msExpires(0), msPeriod(0), callback(func), pContext(context), bArmed(false)
+  {
+  }
+};
+
+class TimerWheel
+{
+  protected:
+
+    static const int RootSlots  = 1 << WHEEL_ROOT_BITS;
+    static const int LevelSlots = 1 << WHEEL_LEVEL_BITS;
+
+    // Each slot is a circular list with a sentinel head, and each level has a bitmap of which
+    // slots hold anything so finding the next deadline never walks the timers themselves
+
+    WheelTimer  _root[RootSlots];
+    WheelTimer  _levels[WHEEL_LEVELS - 1][LevelSlots];
+    uint32_t    _rootBits[RootSlots / 32];
+    uint64_t    _levelBits[WHEEL_LEVELS - 1];
+    uint32_t    _msCurrent;                                 //  Next tick to be processed
+
+    static int Shift(int level)
+    {
+      return WHEEL_ROOT_BITS + (level - 1) * WHEEL_LEVEL_BITS;
+    }
+
+    static void LinkInto(WheelTimer & head, WheelTimer & timer)
+    {
+      timer.pPrev        = head.pPrev;
+      timer.pNext        = &head;
+      head.pPrev->pNext  = &timer;
+      head.pPrev         = &timer;
+    }
+
+    static bool IsEmpty(const WheelTimer & head)
+    {
+      return head.pNext == &head;
+    }
+
+    WheelTimer & SlotOf(const WheelTimer & timer, int & level, int & slot)
+    {
+      // Overdue timers go in the slot about to be processed
+
+      int32_t delta = (int32_t)(timer.msExpires - _msCurrent);
+      if (delta < RootSlots)
+      {
+        level = 0;
+        slot  = (delta < 0 ? _msCurrent : timer.msExpires) & (RootSlots - 1);
+        return _root[slot];
+      }
+
+      // Otherwise the lowest level whose window reaches the deadline, or the far end of the last one
+
+      for (level = 1; level < WHEEL_LEVELS; level++)
+      {
+        uint32_t blocks = ((timer.msExpires >> Shift(level)) - (_msCurrent >> Shift(level))) & (0xFFFFFFFFUL >> Shift(level));
+        if (blocks < LevelSlots || level == WHEEL_LEVELS - 1)
+        {
+          uint32_t block = blocks < LevelSlots ? (timer.msExpires >> Shift(level)) : (_msCurrent >> Shift(level)) + LevelSlots - 1;
+          slot = block & (LevelSlots - 1);
+          return _levels[level - 1][slot];
+        }
+      }
+      return _root[0];                                      //  not reached
+    }
+
+    void File(WheelTimer & timer)
+    {
+      int level, slot;
+      WheelTimer & head = SlotOf(timer, level, slot);
+      LinkInto(head, timer);
+      timer.pSlot = &head;
+
+      if (level == 0)
+        _rootBits[slot >> 5] |= 1UL << (slot & 31);
+      else
+        _levelBits[level - 1] |= 1ULL << slot;
+    }
+
+    static void Unlink(WheelTimer & timer)
+    {
+      timer.pPrev->pNext = timer.pNext;
+      timer.pNext->pPrev = timer.pPrev;
+      timer.pNext = timer.pPrev = nullptr;
+    }
+
+    void ClearBitIfEmpty(WheelTimer & head)
+    {
+      if (!IsEmpty(head))
+        return;
+
+      if (&head >= _root && &head < _root + RootSlots)
+      {
+        int slot = &head - _root;
+        _rootBits[slot >> 5] &= ~(1UL << (slot & 31));
+        return;
+      }
+
+      for (int level = 1; level < WHEEL_LEVELS; level++)
+      {
+        WheelTimer * pLevel = _levels[level - 1];
+        if (&head >= pLevel && &head < pLevel + LevelSlots)
+          _levelBits[level - 1] &= ~(1ULL << (&head - pLevel));
+      }
+    }
+
+    // Moves every timer in a higher level slot down to wherever it belongs now that time has
+    // caught up with it
+
+    void Cascade(int level, int slot)
+    {
+      WheelTimer & head = _levels[level - 1][slot];
+      _levelBits[level - 1] &= ~(1ULL << slot);
+
+      while (!IsEmpty(head))
+      {
+        WheelTimer & timer = *head.pNext;
+        Unlink(timer);
+        File(timer);
+      }
+    }
+
+    void RunSlot(int slot)
+    {
+      WheelTimer & head = _root[slot];
+
+      while (!IsEmpty(head))
+      {
+        WheelTimer & timer = *head.pNext;
+        Unlink(timer);
+        timer.bArmed = false;
+
+        if (timer.msPeriod)
+        {
+          timer.msExpires += timer.msPeriod;                //  from the deadline, not from now, so there's no drift
+
+          // If the wheel was held up for more than a period, skip the missed runs but keep the phase
+
+          int32_t late = (int32_t)(_msCurrent - timer.msExpires);
+          if (late >= 0)
+            timer.msExpires += (late / timer.msPeriod + 1) * timer.msPeriod;
+          timer.bArmed = true;
+          File(timer);
+        }
+
+        if (timer.callback)
+          timer.callback(timer.pContext);
+      }
+      _rootBits[slot >> 5] &= ~(1UL << (slot & 31));
+    }
+
+    // Distance in ticks from 'from' to the first set bit at or after it, wrapping around
+
+    static int NextRootSlot(const uint32_t * bits, int from)
+    {
+      for (int i = 0; i < RootSlots; i += 32)
+      {
+        int word = ((from + i) & (RootSlots - 1)) >> 5;
+        uint32_t mask = bits[word];
+        if (i == 0)
+          mask &= ~0UL << (from & 31);
+        if (mask)
+        {
+          int slot = (word << 5) + __builtin_ctz(mask);
+          return (slot - from) & (RootSlots - 1);
+        }
+      }
+
+      // Only the bits below 'from' in its own word are left
+
+      uint32_t mask = bits[from >> 5] & ((1UL << (from & 31)) - 1);
+      return mask ? ((from & ~31) + __builtin_ctz(mask) - from) & (RootSlots - 1) : -1;
+    }
+
+    static int NextLevelSlot(uint64_t bits, int from)
+    {
+      if (!bits)
+        return -1;
+
+      uint64_t rotated = (bits >> from) | (from ? bits << (LevelSlots - from) : 0);
+      return __builtin_ctzll(rotated);
+    }
+
+  public:
+
+    TimerWheel()
+      : _msCurrent(0)
+    {
+      for (int i = 0; i < RootSlots; i++)
+        _root[i].pNext = _root[i].pPrev = &_root[i];
+
+      for (int level = 0; level < WHEEL_LEVELS - 1; level++)
+      {
+        for (int i = 0; i < LevelSlots; i++)
+          _levels[level][i].pNext = _levels[level][i].pPrev = &_levels[level][i];
+        _levelBits[level] = 0;
+      }
+
+      memset(_rootBits, 0, sizeof(_rootBits));
+    }
+
+    // Begin
+    //
+    // Sets the wheel's clock; call once before adding timers
+
+    void Begin(uint32_t msNow)
+    {
+      _msCurrent = msNow;
+    }
+
+    // Add
+    //
+    // Arms a timer msDelay from now, and then every msPeriod after that if msPeriod isn't 0.  A
+    // timer that is already armed is moved to the new deadline.
+
+    void Add(WheelTimer & timer, uint32_t msNow, uint32_t msDelay, uint32_t msPeriod = 0)
+    {
+      Remove(timer);
+      timer.msExpires = msNow + msDelay;
+      timer.msPeriod  = msPeriod;
+      timer.bArmed    = true;
+      File(timer);
+    }
+
+    void Remove(WheelTimer & timer)
+    {
+      if (!timer.bArmed)
+        return;
+
+      Unlink(timer);
+      timer.bArmed = false;
+      ClearBitIfEmpty(*timer.pSlot);
+    }
+
+    // Advance
+    //
+    // Processes every tick up to and including msNow, cascading higher levels as their slots come
+    // due and running expired timers.  Runs of empty ticks are skipped to the next level 0 lap.
+
+    void Advance(uint32_t msNow)
+    {
+      while ((int32_t)(msNow - _msCurrent) >= 0)
+      {
+        int slot = _msCurrent & (RootSlots - 1);
+
+        if (slot == 0)
+        {
+          for (int level = WHEEL_LEVELS - 1; level >= 1; level--)
+          {
+            uint32_t below = (1UL << Shift(level)) - 1;
+            if ((_msCurrent & below) == 0)
+              Cascade(level, (_msCurrent >> Shift(level)) & (LevelSlots - 1));
+          }
+        }
+
+        int next = NextRootSlot(_rootBits, slot);
+        if (next == 0)
+        {
+          RunSlot(slot);
+          _msCurrent++;
+        }
+        else
+        {
+          // Nothing due this tick; jump ahead to the next occupied slot or the end of this lap,
+          // whichever comes first, but never past msNow
+
+          uint32_t lapEnd = RootSlots - slot;
+          uint32_t jump   = (next > 0 && (uint32_t) next < lapEnd) ? next : lapEnd;
+          _msCurrent += min(jump, msNow - _msCurrent + 1);
+        }
+      }
+    }
+
+    // NextDeadline
+    //
+    // Milliseconds from msNow until the wheel next has work to do, either a timer expiring or a
+    // higher level slot cascading, or WHEEL_NO_DEADLINE when nothing is armed
+
+    uint32_t NextDeadline(uint32_t msNow) const
+    {
+      uint32_t msAt   = WHEEL_NO_DEADLINE;
+      uint32_t msNext = WHEEL_NO_DEADLINE;                  //  Ticks from _msCurrent to msAt
+
+      int next = NextRootSlot(_rootBits, _msCurrent & (RootSlots - 1));
+      if (next >= 0)
+      {
+        msNext = next;
+        msAt   = _msCurrent + next;
+      }
+
+      // A higher level slot can hold a timer that falls due before the next one in level 0, so its
+      // boundary counts as a deadline too; waking there just cascades it and the loop asks again
+
+      for (int level = 1; level < WHEEL_LEVELS; level++)
+      {
+        uint32_t block = _msCurrent >> Shift(level);
+        bool     bEdge = (_msCurrent & ((1UL << Shift(level)) - 1)) == 0;
+
+        // A slot whose boundary is this very tick hasn't been cascaded yet
+
+        uint32_t first = block + (bEdge ? 0 : 1);
+        int skip = NextLevelSlot(_levelBits[level - 1], first & (LevelSlots - 1));
+        if (skip < 0)
+          continue;
+
+        uint32_t boundary = (first + skip) << Shift(level);
+        if (boundary - _msCurrent < msNext)
+        {
+          msNext = boundary - _msCurrent;
+          msAt   = boundary;
+        }
+      }
+
+      if (msAt == WHEEL_NO_DEADLINE)
+        return WHEEL_NO_DEADLINE;
+
+      return (int32_t)(msAt - msNow) > 0 ? msAt - msNow : 0;
+    }
+};
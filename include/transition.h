@@ -0,0 +1,246 @@
+//+--------------------------------------------------------------------------
+//
+// File:        transition.h
+//
+// Description:
+//
+//      Timed crossfade, wipe and dissolve transitions between two effects.
+//      The outgoing and incoming effects each keep their own frame buffer
+//      and are composited into h_LEDs with a packed 8-bit lerp.
+//
+// History:     Oct-19-2026     tomwer      Created
+//                              tomwer      Restarting mid-transition keeps the incoming frame
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+#include <string.h>
+
+extern CRGB h_LEDs[];
+
+typedef void (*EffectDrawFunc)();
+
+enum TransitionStyle
+{
+  Crossfade = 0,
+  Wipe      = 1,
+  Dissolve  = 2
+};
+
+// BlendWeighted
+//
+// out = (from * weightFrom + to * weightTo) / 256, for every channel of every pixel, where the two
+// weights add up to no more than 256.  The buffers are walked as 32-bit words and the even and odd
+// bytes are split into two 0x00FF00FF lanes, so one multiply-add handles two channels.  Each 16-bit
+// lane peaks at 255 * 256, so nothing carries into its neighbour.
+
+inline void BlendWeighted(CRGB * out, const CRGB * from, const CRGB * to, size_t count, uint32_t weightFrom, uint32_t weightTo)
+{
+  uint8_t       * pOut  = (uint8_t *) out;
+  const uint8_t * pFrom = (const uint8_t *) from;
+  const uint8_t * pTo   = (const uint8_t *) to;
+
+  const size_t   bytes   = count * sizeof(CRGB);
+  const uint32_t weightA = weightFrom;
+  const uint32_t weightB = weightTo;
+  size_t i = 0;
+
+  for (; i + sizeof(uint32_t) <= bytes; i += sizeof(uint32_t))
+  {
+    uint32_t a, b;
+    memcpy(&a, pFrom + i, sizeof(a));                               //  memcpy keeps unaligned CRGB arrays legal
+    memcpy(&b, pTo + i, sizeof(b));
+
+    uint32_t even = (((a & 0x00FF00FF) * weightA + (b & 0x00FF00FF) * weightB) >> 8) & 0x00FF00FF;
+    uint32_t odd  = (((a >> 8) & 0x00FF00FF) * weightA + ((b >> 8) & 0x00FF00FF) * weightB) & 0xFF00FF00;
+    uint32_t mix  = even | odd;
+
+    memcpy(pOut + i, &mix, sizeof(mix));
+  }
+
+  // Whatever is left over when the byte count isn't a multiple of four
+
+  for (; i < bytes; i++)
+    pOut[i] = (pFrom[i] * weightA + pTo[i] * weightB) >> 8;
+}
+
+// BlendBuffers
+//
+// out = from + (to - from) * amount / 256.  amount runs 0 - 256 so that 256 lands exactly on 'to'.
+
+inline void BlendBuffers(CRGB * out, const CRGB * from, const CRGB * to, size_t count, uint16_t amount)
+{
+  BlendWeighted(out, from, to, count, 256 - amount, amount);
+}
+
+class TransitionEngine
+{
+  protected:
+
+    size_t          _cLength;
+    CRGB *          _fromLEDs;          // Outgoing effect's private frame buffer
+    CRGB *          _toLEDs;            // Incoming effect's private frame buffer
+    TransitionStyle _style;
+    unsigned long   _msStart;
+    unsigned long   _msDuration;
+    bool            _bActive;
+    unsigned long   _usLastBlend;       // Cost of the most recent composite, in microseconds
+    uint32_t        _fromGain;          // Brightness + 1 applied to each side in the current composite
+    uint32_t        _toGain;
+
+    // Swap the effect's buffer into h_LEDs, let it draw a frame, and swap it back out again
+
+    void DrawInto(CRGB * buffer, EffectDrawFunc draw)
+    {
+      memcpy(h_LEDs, buffer, _cLength * sizeof(CRGB));
+      draw();
+      memcpy(buffer, h_LEDs, _cLength * sizeof(CRGB));
+    }
+
+    void DrawWipe(uint8_t amount)
+    {
+      // Everything below the edge shows the new effect, everything above the old one, and the
+      // pixel straddling the edge is blended so the wipe moves smoothly
+
+      uint32_t edge  = (uint32_t) _cLength * amount;
+      size_t   iEdge = edge >> 8;
+      uint32_t frac  = edge & 0xFF;
+
+      BlendWeighted(h_LEDs, _toLEDs, _toLEDs, iEdge, _toGain, 0);
+      if (iEdge < _cLength)
+      {
+        BlendWeighted(&h_LEDs[iEdge], &_fromLEDs[iEdge], &_toLEDs[iEdge], 1, ((256 - frac) * _fromGain) >> 8, (frac * _toGain) >> 8);
+        BlendWeighted(&h_LEDs[iEdge + 1], &_fromLEDs[iEdge + 1], &_fromLEDs[iEdge + 1], _cLength - iEdge - 1, _fromGain, 0);
+      }
+    }
+
+    void DrawDissolve(uint8_t amount)
+    {
+      // Multiplying by an odd constant permutes 0-255, so every pixel in a 256 pixel run gets
+      // its own switch-over point and the dissolve looks scattered rather than swept
+
+      for (size_t i = 0; i < _cLength; i++)
+      {
+        uint8_t  threshold = (uint8_t)(i * 151 + (i >> 8) * 37);
+        bool     bTo  = threshold < amount;
+        uint32_t gain = bTo ? _toGain : _fromGain;
+
+        h_LEDs[i] = bTo ? _toLEDs[i] : _fromLEDs[i];
+        if (gain != 256)
+          h_LEDs[i].nscale8(gain - 1);
+      }
+    }
+
+  public:
+
+    TransitionEngine(size_t cLength)
+      : _cLength(cLength),
+        _style(Crossfade),
+        _msStart(0),
+        _msDuration(0),
+        _bActive(false),
+        _usLastBlend(0),
+        _fromGain(256),
+        _toGain(256)
+    {
+      _fromLEDs = new CRGB[cLength];
+      _toLEDs   = new CRGB[cLength];
+    }
+
+    virtual ~TransitionEngine()
+    {
+      delete [] _fromLEDs;
+      delete [] _toLEDs;
+    }
+
+    // Start
+    //
+    // Takes whatever is on the strip as the outgoing frame and starts the incoming effect from
+    // black, so effects that never clear don't inherit stale pixels from the previous one.
+    //
+    // Started again before the last one is over, the transition is cut short: the effect that was
+    // coming in becomes the outgoing one and carries on from its own frame, since h_LEDs then
+    // holds the composite or whichever side drew last rather than anything that effect drew.
+
+    void Start(TransitionStyle style, unsigned long msDuration)
+    {
+      memcpy(_fromLEDs, _bActive ? _toLEDs : h_LEDs, _cLength * sizeof(CRGB));
+      memset((void *) _toLEDs, 0, _cLength * sizeof(CRGB));
+
+      _style      = style;
+      _msStart    = millis();
+      _msDuration = max(1UL, msDuration);
+      _bActive    = true;
+    }
+
+    bool IsActive() const
+    {
+      return _bActive;
+    }
+
+    unsigned long LastBlendMicros() const
+    {
+      return _usLastBlend;
+    }
+
+    void DrawOutgoing(EffectDrawFunc draw)
+    {
+      DrawInto(_fromLEDs, draw);
+    }
+
+    void DrawIncoming(EffectDrawFunc draw)
+    {
+      DrawInto(_toLEDs, draw);
+    }
+
+    // Compose
+    //
+    // Writes the blend of both buffers into h_LEDs along an eased curve.  Once the duration has
+    // elapsed the incoming buffer is handed over to h_LEDs as-is and the transition ends.
+    //
+    // fromBrightness and toBrightness scale each side on the way into the blend, for when only
+    // one of the two effects has the strip's brightness in its pixels already and the composite
+    // goes out unscaled; the handed over frame is left as the incoming effect drew it.
+
+    void Compose(uint8_t fromBrightness = 255, uint8_t toBrightness = 255)
+    {
+      if (!_bActive)
+        return;
+
+      unsigned long elapsed = millis() - _msStart;
+      if (elapsed >= _msDuration)
+      {
+        memcpy(h_LEDs, _toLEDs, _cLength * sizeof(CRGB));
+        _bActive = false;
+        return;
+      }
+
+      uint8_t amount = ease8InOutQuad((uint8_t)(elapsed * 255 / _msDuration));
+      unsigned long usStart = micros();
+
+      _fromGain = fromBrightness + 1;
+      _toGain   = toBrightness + 1;
+
+      switch (_style)
+      {
+        case Wipe:
+          DrawWipe(amount);
+          break;
+
+        case Dissolve:
+          DrawDissolve(amount);
+          break;
+
+        case Crossfade:
+        default:
+          BlendWeighted(h_LEDs, _fromLEDs, _toLEDs, _cLength, ((256 - amount) * _fromGain) >> 8, (amount * _toGain) >> 8);
+          break;
+      }
+
+      _usLastBlend = micros() - usStart;
+    }
+};
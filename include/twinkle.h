@@ -17,6 +17,8 @@
 #include <FastLED.h>
 
 // #include "ledgfx.h"
+#include "sparkle.h"
+
 #define TWINKLE_SPEED   50      //  value in milliseconds, best results under 100
 #define NUM_COLORS      5       //  size of the TwinkleColors array
 static const CRGB TwinkleColors [NUM_COLORS] = 
@@ -28,45 +30,27 @@ static const CRGB TwinkleColors [NUM_COLORS] =
     CRGB::Yellow
 };
 
-void DrawTwinkle(){
-
-    static int passCount = 0;
-    passCount++;
+//  Each twinkle runs its own engine from sparkle.h, so the three keep their own sparkles when a
+//  transition draws two of them at once.  They used to light random pixels at full brightness and
+//  clear the whole strip every so often; now every sparkle fades up and back out by itself.
 
-    //  Every time passCount hits a quarter of the LED total, we reset the strip
-    if (passCount == NUM_LEDS){
+TwinkleEngine twinkles(NUM_LEDS, TwinkleColors, NUM_COLORS);                 //  every rate
+TwinkleEngine quickTwinkles(NUM_LEDS, TwinkleColors, NUM_COLORS, 4, 7);      //  short lived, so fewer are lit at once
+TwinkleEngine slowTwinkles(NUM_LEDS, TwinkleColors, NUM_COLORS, 0, 1);       //  long, slow swells
 
-        passCount = 0;
-        FastLED.clear(false);                                        //  Clear the strip, but don't push the bits out yet
-    }
+void DrawTwinkle(){
 
-    h_LEDs[random(NUM_LEDS)] = TwinkleColors[random(NUM_COLORS)];
-    delay(TWINKLE_SPEED);
+    twinkles.DrawFrame(h_LEDs, 1);
 }
 
 void DrawTwinkleTwo(){
 
-    static int passCount = 0;
-    passCount++;
-
-    //  Every time passCount hits a quarter of the LED total, we reset the strip
-    if (passCount == NUM_LEDS / 4){
-
-        passCount = 0;
-        FastLED.clear(false);                                        //  Clear the strip, but don't push put the bits yet
-    }
-
-    h_LEDs[random(NUM_LEDS)] = TwinkleColors[random(NUM_COLORS)];
-    delay(200);
+    quickTwinkles.DrawFrame(h_LEDs, 1);
 }
 
+//  One new pixel per frame, as before, but at its 200 ms frame interval the slowest envelopes
+//  keep most of the strip lit
 void DrawTwinkleOne()
 {
-    FastLED.clear(false);                                        //  Clear the strip, but don't push put the bits yet
-
-    for (int i = 0; i < NUM_LEDS; i++){
-        h_LEDs[random(NUM_LEDS)] = TwinkleColors[random(NUM_COLORS)];
-        FastLED.show(h_Brightness);
-        delay(200);
-    }
-}
\ No newline at end of file
+    slowTwinkles.DrawFrame(h_LEDs, 1);
+}
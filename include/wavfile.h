@@ -0,0 +1,196 @@
+//+--------------------------------------------------------------------------
+//
+// File:        wavfile.h
+//
+// Description:
+//
+//      Reads PCM WAV files as signed 16-bit mono samples, for feeding a
+//      recording to SoundAnalyzer::AddSamples so the analysis can be run
+//      over the same audio again and again.  Plain stdio, so it works on
+//      the host and on any filesystem the ESP32 has mounted.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+
+class WavReader
+{
+  protected:
+
+    FILE *      _file;
+    bool        _bOwnsFile;
+    uint32_t    _sampleRate;
+    uint16_t    _channels;
+    uint16_t    _bitsPerSample;
+    uint32_t    _dataRemaining;                     //  Bytes of sample data not read yet
+
+    static uint32_t Le32(const uint8_t * p)
+    {
+      return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t) p[3] << 24);
+    }
+
+    static uint16_t Le16(const uint8_t * p)
+    {
+      return p[0] | (p[1] << 8);
+    }
+
+    // Walks the RIFF chunks up to the start of the sample data, picking up the format on the way
+
+    bool ReadHeader()
+    {
+      uint8_t header[12];
+      if (fread(header, 1, sizeof(header), _file) != sizeof(header) || memcmp(header, "RIFF", 4) || memcmp(header + 8, "WAVE", 4))
+        return false;
+
+      bool bFormat = false;
+      uint8_t chunk[8];
+
+      while (fread(chunk, 1, sizeof(chunk), _file) == sizeof(chunk))
+      {
+        uint32_t size = Le32(chunk + 4);
+
+        if (!memcmp(chunk, "fmt ", 4) && size >= 16)
+        {
+          uint8_t format[16];
+          if (fread(format, 1, sizeof(format), _file) != sizeof(format))
+            return false;
+
+          _channels      = Le16(format + 2);
+          _sampleRate    = Le32(format + 4);
+          _bitsPerSample = Le16(format + 14);
+          bFormat = Le16(format) == 1 && _channels > 0 && (_bitsPerSample == 8 || _bitsPerSample == 16);
+          size -= sizeof(format);
+        }
+        else if (!memcmp(chunk, "data", 4))
+        {
+          _dataRemaining = size;
+          return bFormat;
+        }
+
+        if (fseek(_file, size + (size & 1), SEEK_CUR))       //  chunks are padded to an even length
+          return false;
+      }
+      return false;
+    }
+
+  public:
+
+    WavReader()
+      : _file(nullptr),
+        _bOwnsFile(false),
+        _sampleRate(0),
+        _channels(0),
+        _bitsPerSample(0),
+        _dataRemaining(0)
+    {
+    }
+
+    virtual ~WavReader()
+    {
+      Close();
+    }
+
+    // Open
+    //
+    // False unless the file is uncompressed 8 or 16-bit PCM.  The FILE * form leaves the file open
+    // on Close, for callers that made it themselves (like tmpfile()).
+
+    bool Open(const char * path)
+    {
+      Close();
+      _file = fopen(path, "rb");
+      _bOwnsFile = true;
+      return _file && ReadHeader();
+    }
+
+    bool Open(FILE * file)
+    {
+      Close();
+      _file = file;
+      _bOwnsFile = false;
+      return _file && ReadHeader();
+    }
+
+    void Close()
+    {
+      if (_file && _bOwnsFile)
+        fclose(_file);
+      _file = nullptr;
+      _dataRemaining = 0;
+    }
+
+    uint32_t SampleRate() const
+    {
+      return _sampleRate;
+    }
+
+    // Read
+    //
+    // Up to 'count' samples, with the channels averaged down to mono and 8-bit data widened to 16.
+    // Returns how many were read, 0 at the end of the data.
+
+    size_t Read(int16_t * samples, size_t count)
+    {
+      if (!_file)
+        return 0;
+
+      const size_t frameBytes = _channels * _bitsPerSample / 8;
+      uint8_t frame[16];
+      size_t read = 0;
+
+      if (frameBytes > sizeof(frame))
+        return 0;
+
+      while (read < count && _dataRemaining >= frameBytes && fread(frame, 1, frameBytes, _file) == frameBytes)
+      {
+        int32_t sum = 0;
+        for (uint16_t c = 0; c < _channels; c++)
+          sum += _bitsPerSample == 16 ? (int16_t) Le16(frame + c * 2) : (frame[c] - 128) << 8;
+
+        samples[read++] = sum / _channels;
+        _dataRemaining -= frameBytes;
+      }
+      return read;
+    }
+};
+
+// WriteWav
+//
+// Writes 16-bit mono samples as a WAV file, for making test recordings
+
+inline bool WriteWav(FILE * file, const int16_t * samples, size_t count, uint32_t sampleRate)
+{
+  uint32_t dataBytes = count * sizeof(int16_t);
+  uint8_t  header[44];
+
+  memcpy(header, "RIFF", 4);
+  memcpy(header + 8, "WAVEfmt ", 8);
+  memcpy(header + 36, "data", 4);
+
+  const uint32_t fields32[][2] = { { 4, 36 + dataBytes }, { 16, 16 }, { 24, sampleRate }, { 28, sampleRate * 2 }, { 40, dataBytes } };
+  const uint16_t fields16[][2] = { { 20, 1 }, { 22, 1 }, { 32, 2 }, { 34, 16 } };
+
+  for (const auto & field : fields32)
+    for (int i = 0; i < 4; i++)
+      header[field[0] + i] = field[1] >> (i * 8);
+  for (const auto & field : fields16)
+    for (int i = 0; i < 2; i++)
+      header[field[0] + i] = field[1] >> (i * 8);
+
+  if (fwrite(header, 1, sizeof(header), file) != sizeof(header))
+    return false;
+
+  for (size_t i = 0; i < count; i++)
+  {
+    uint8_t bytes[2] = { (uint8_t) samples[i], (uint8_t)(samples[i] >> 8) };
+    if (fwrite(bytes, 1, sizeof(bytes), file) != sizeof(bytes))
+      return false;
+  }
+  return true;
+}
@@ -11,6 +11,7 @@
 //  History:      Feb-7-2022    tomwer    Copied for personal use and learning
 //                Feb-22-2022   me        refactored with EVERY_N_MILLISECONDS
 //                                        refactored comet using beat timers
+//                Oct-19-2026   tomwer    effect table with transitions, event driven loop
 //
 //---------------------------------------------------------------------------------
 
@@ -31,6 +32,8 @@ U8G2_SSD1306_128X64_NONAME_F_HW_I2C h_oled(U8G2_R2, OLED_RST, OLED_SCL, OLED_SDA
 #define NUM_LEDS        60          // number of LEDs - using 60 out of 60
 #define UK_LEDS         30
 #define LED_PIN         5
+#define MATRIX_WIDTH    6           // the strip folded into a serpentine panel for the 2D effects; MATRIX_WIDTH * MATRIX_HEIGHT
+#define MATRIX_HEIGHT   10          // must not exceed NUM_LEDS
 CRGB h_LEDs[NUM_LEDS] = {0};       // Frame buffer for FastLED
 
 int h_lineHeight = 0;              //  Line height based on current font
@@ -38,16 +41,13 @@ int h_Brightness = 128;             //  brightness range 0 - 255  !!! CAUTION: s
 int h_PowerLimit = 3000;           //  900mW Power Limit
 
 #define ARRAYSIZE(x) (sizeof(x) / sizeof(x[0]))
-#define TIMES_PER_SECOND(x) EVERY_N_MILLISECONDS(1000 / x)
 
-// LED effect headers
-#include "ledgfx.h"
-#include "marquee.h"
-#include "twinkle.h"
-#include "comet.h"
-#include "bounce.h"
-#include "fire.h"
-#include "lightmystrip.h"
+// LED effects, the table of them and their parameters
+#include "effects.h"
+#include "eventloop.h"
+#include "effectslot.h"
+#include "telemetry.h"
+#include "showconfig.h"
 
 //-----------------------------------------------------------------------------------------------------------------------------
 // FramesPerSecond  ->  depricated
@@ -62,25 +62,381 @@ int h_PowerLimit = 3000;           //  900mW Power Limit
 // }
 //------------------------------------------------------------------------------------------------------------------------------
 
-//  Bouncing Ball Effect
+#define TRANSITION_MS         1000                                //  Length of the blend between two effects
+#define TRANSITION_FRAME_MS   10                                  //  How often the blend is recomposited
+
+TransitionEngine    transition(NUM_LEDS);
+TransitionStyle     transitionStyle = Crossfade;
+FreeRTOSEventSource eventSource;                                  //  The loop sleeps on a FreeRTOS queue
+EventLoop           events(eventSource);
+ParameterAutomation automation;                                   //  Keyframed timelines on effect parameters, see effects.h
+
+EffectSlot currentSlot;
+EffectSlot outgoingSlot;
+
+WheelTimer composeTimer;                                          //  Recomposites the transition every TRANSITION_FRAME_MS
+WheelTimer statsTimer;                                            //  One-shot, armed by the first frame after a refresh
+WheelTimer powerTimer;                                            //  Likewise for the power estimate
+WheelTimer telemetryTimer;                                        //  Periodic while telemetry is on, see ConfigureTelemetry
+WheelTimer saveTimer;                                             //  One-shot, writes the show to flash once it has settled
+
+#define TELEMETRY_BT_CHUNK    330                                 //  One SPP packet (SPP_TX_MAX in BluetoothSerial.cpp) per telemetry period
+
+TelemetryStream telemetry;
+bool            bTelemetryBT = false;                             //  Telemetry goes to ESP_BT rather than Serial
+volatile bool   bBTCongested = false;                             //  The SPP stack has said it can't take more, see OnSppEvent
+
+uint32_t h_PowerMilliwatts = 0;                                   //  Unscaled draw of the current frame
+uint8_t  h_MaxBrightness   = 0;                                   //  Brightness after power throttling
+uint16_t h_ThrottleEvents  = 0;                                   //  Power checks that found the strip throttled
+unsigned long h_FrameMicros = 0;                                  //  Time to draw the last effect frame
+unsigned long h_ShowMicros  = 0;                                  //  Time the last FastLED.show() took
+volatile uint32_t h_InputDropped = 0;                             //  Bluetooth bytes that found no room in the loop's input
+
+const LedEffect * EffectsByKey[128];                              //  Effects indexed by key, filled in by IndexEffects
+
+void IndexEffects(){
+
+  for (size_t i = 0; i < ARRAYSIZE(Effects); i++)
+    EffectsByKey[Effects[i].key & 0x7F] = &Effects[i];
+}
+
+const LedEffect * FindEffect(char key){
+
+  return (uint8_t) key < ARRAYSIZE(EffectsByKey) ? EffectsByKey[(uint8_t) key] : nullptr;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+// Frame budget
+//
+//  Every effect frame is timed, and one that takes longer than its share of the frame is reported on Serial (at most once a
+//  second) so a slow change to an effect shows up as soon as it runs rather than as a vague drop in FPS.
+
+#define FRAME_BUDGET_US   (NUM_LEDS * 2)                          //  2 us per LED: 120 us at 60 LEDs, 2 ms at 1000
+
+void CheckFrameBudget(const LedEffect * pEffect, unsigned long usStart){
+
+  static unsigned long msLastReport = 0;
+
+  unsigned long usDraw = micros() - usStart;
+  h_FrameMicros = usDraw;
+  if (usDraw > FRAME_BUDGET_US && millis() - msLastReport > 1000){
+
+    Serial.printf("Effect '%c' over budget: %lu us > %u us\n", pEffect->key, usDraw, FRAME_BUDGET_US);
+    msLastReport = millis();
+  }
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+// Timer and event handlers
 //
-// (length, count, fade, mirrored)
-// Creating instance of BouncingBallEffect called balls
-BouncingBallEffect balls(NUM_LEDS, 8, 32, true);
-IceFireEffect ice(NUM_LEDS, 30, 100, 3, 4, true, true);           // f-f = end -> 0 : t-f = 0 -> end : f-t = center -> out : t-t = ends -> center
-FireEffect fire(NUM_LEDS, 30, 100, 3, 4, true, true);             // f-f = end -> 0 : t-f = 0 -> end : f-t = center -> out : t-t = ends -> center
-
-void MyIceFire(){
-    FastLED.clear();
-    ice.DrawIceFire();
-    FastLED.show(h_Brightness);
-};
-
-void MyFire(){
-    FastLED.clear();
-    fire.DrawFire();
-    FastLED.show(h_Brightness);
-};
+//  Every periodic job is a timer on the event loop's timer wheel, and loop() only ever handles input.  Effects repeat at
+//  their own frame interval, static effects fire once, and the stats and power timers are only re-armed by frames, so
+//  once nothing is animating there are no timers left and the loop sleeps until the next key.  See effectslot.h.
+
+void ShowFrame(uint8_t brightness){
+
+  unsigned long usStart = micros();
+  FastLED.show(brightness);
+  h_ShowMicros = micros() - usStart;
+}
+
+//  Brightness FastLED applies to a slot's frames on the way out: none for an effect that scales itself
+uint8_t ShowBrightness(const EffectSlot & slot){
+
+  return slot.pEffect && slot.pEffect->bScaled ? 255 : h_Brightness;
+}
+
+//  Audio analysis and the parameter timelines belong to the frame, not to the effect.  During a transition both slots
+//  are scheduled from the same moment, so they come due on the same tick wherever their intervals line up, and only the
+//  first one to draw on a tick updates them.
+unsigned long h_InputsMillis = 0;
+bool          h_bInputsValid = false;
+
+void UpdateFrameInputs(){
+
+  unsigned long msNow = millis();
+  if (h_bInputsValid && msNow == h_InputsMillis)
+    return;
+
+  h_InputsMillis = msNow;
+  h_bInputsValid = true;
+  audio.Update();                                                           //  analyze new samples before anything draws
+  automation.Evaluate(msNow);                                               //  and move animated parameters to this frame
+}
+
+void DrawSlot(void * pContext){
+
+  EffectSlot & slot = *(EffectSlot *) pContext;
+
+  UpdateFrameInputs();
+
+  unsigned long usStart = micros();
+  bool bTransition = transition.IsActive();
+  if (bTransition){
+
+    if (&slot == &outgoingSlot)
+      transition.DrawOutgoing(slot.pEffect->draw);
+    else
+      transition.DrawIncoming(slot.pEffect->draw);                          //  composeTimer puts it on the strip
+  }
+  else
+    slot.pEffect->draw();
+
+  CheckFrameBudget(slot.pEffect, usStart);                                  //  the effect alone; show is timed separately
+  if (!bTransition)
+    ShowFrame(ShowBrightness(slot));
+  FrameDrawn(events, statsTimer, powerTimer);
+}
+
+void ComposeTransition(void *){
+
+  //  Both sides have to reach the strip equally bright.  When only one of them has h_Brightness in its pixels the
+  //  other one is scaled in the blend and the composite goes out unscaled.
+  uint8_t fromBrightness = ShowBrightness(outgoingSlot);
+  uint8_t toBrightness   = ShowBrightness(currentSlot);
+
+  if (fromBrightness == toBrightness){
+
+    transition.Compose();
+    ShowFrame(toBrightness);
+  }
+  else{
+
+    transition.Compose(fromBrightness, toBrightness);
+    ShowFrame(transition.IsActive() ? 255 : toBrightness);
+  }
+  FrameDrawn(events, statsTimer, powerTimer);
+
+  if (!transition.IsActive()){
+
+    events.Cancel(composeTimer);
+    events.Cancel(outgoingSlot.timer);
+    outgoingSlot.pEffect = nullptr;
+  }
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+// Saved show
+//
+//  The selected effect, transition style, parameter values and timelines are written to flash SAVE_DELAY_MS after the
+//  last change, so flipping through effects costs one write rather than one per key, and setup() puts the show back on
+//  the strip before anything slow has started.  Restored timelines start over from their first key.
+
+#define SAVE_DELAY_MS   5000
+
+ShowStore     showStore;
+uint8_t       showTimelines[AUTOMATION_TIMELINE_BYTES];           //  ParameterAutomation::SaveTimelines on its way to or from flash
+unsigned long h_FirstFrameMicros = 0;                             //  Boot to the first frame on the strip
+
+void ShowChanged(){
+
+  events.Schedule(saveTimer, SAVE_DELAY_MS);
+}
+
+void SaveShow(void *){
+
+  ShowConfig config = {};
+  config.effect     = currentSlot.pEffect ? currentSlot.pEffect->key : 0;
+  config.transition = transitionStyle;
+  config.schema     = automation.SchemaHash();
+  config.paramCount = automation.Snapshot(config.params, AUTOMATION_MAX_PARAMS);
+  config.timelineBytes = automation.SaveTimelines(showTimelines);
+
+  if (!showStore.Save(config, showTimelines))
+    Serial.println("Could not save the show");
+}
+
+const LedEffect * RestoreShow(){
+
+  ShowConfig config;
+  if (!showStore.Load(config, showTimelines))
+    return nullptr;
+
+  //  A byte from flash, so only trust it if it names a style we have
+  transitionStyle = config.transition <= Dissolve ? (TransitionStyle) config.transition : Crossfade;
+  if (config.schema == automation.SchemaHash()){                      //  parameters saved by a build with different ones don't apply
+
+    automation.Restore(config.params, config.paramCount);
+    if (!automation.LoadTimelines(showTimelines, config.timelineBytes, millis()))
+      Serial.println("Saved timelines didn't load");
+  }
+
+  return FindEffect(config.effect);
+}
+
+void HandleKey(char key){
+
+  //  A key selects the effect that keeps running until the next key.  The old effect keeps drawing into its own
+  //  buffer while the transition blends it out.  'x', 'y' and 'z' pick the transition style for the next switch.
+  if (key == 'x') transitionStyle = Crossfade;
+  if (key == 'y') transitionStyle = Wipe;
+  if (key == 'z') transitionStyle = Dissolve;
+  if (key == 'x' || key == 'y' || key == 'z')
+    ShowChanged();
+
+  const LedEffect * pSelected = FindEffect(key);
+  if (!pSelected || pSelected == currentSlot.pEffect)
+    return;
+
+  if (pSelected->params)
+    Serial.printf("Effect '%c': %s, parameters %s.*\n", key, pSelected->name, pSelected->params);
+  else
+    Serial.printf("Effect '%c': %s\n", key, pSelected->name);
+  ShowChanged();
+
+  events.Cancel(outgoingSlot.timer);
+  events.Cancel(currentSlot.timer);
+
+  if (currentSlot.pEffect){
+
+    //  A static effect's buffer already holds its picture, so only an animated one needs to keep drawing.  A key during
+    //  a transition cuts it short: the incoming effect goes out from its own frame (see TransitionEngine::Start) and
+    //  the one that was going out is dropped.
+    outgoingSlot.pEffect = currentSlot.pEffect;
+    if (outgoingSlot.pEffect->msPerFrame != STATIC_EFFECT)
+      StartSlot(events, outgoingSlot, outgoingSlot.pEffect, outgoingSlot.pEffect->msPerFrame);
+
+    transition.Start(transitionStyle, TRANSITION_MS);
+    events.Schedule(composeTimer, 0, TRANSITION_FRAME_MS);
+  }
+
+  StartSlot(events, currentSlot, pSelected, 0);                                     //  draw the first frame right away
+}
+
+//-----------------------------------------------------------------------------------------------------------------------------
+// Command lines
+//
+//  A line starting with '@' is a timeline rather than keys, eg: "@comet.speed 0=0.2 2000=1.5/3 4000=0.2" then a newline.
+//  See ParameterAutomation::Load for the format and automation.h for the easing curve numbers.
+//
+//  A line starting with '#' sets up telemetry: "#s100" sends a record every 100 ms on Serial, "#b1000" every second over
+//  Bluetooth, and "#0" stops it.
+//
+//  If a line's newline goes missing the line is dropped rather than swallowing the keys after it: a fresh '@' or '#'
+//  starts a new line, and a line that goes quiet for COMMAND_IDLE_MS is abandoned.
+
+#define COMMAND_MAX       160
+#define COMMAND_IDLE_MS   2000
+
+char          commandLine[COMMAND_MAX];
+size_t        commandLength = 0;
+char          commandType   = 0;                                  //  '@' or '#' while a line is coming in, otherwise 0
+unsigned long commandLastMs = 0;                                  //  When the line last got a byte
+
+void ConfigureTelemetry(const char * line){
+
+  bTelemetryBT = line[0] == 'b';
+  if (line[0] == 'b' || line[0] == 's')
+    line++;
+
+  unsigned long msPeriod = strtoul(line, nullptr, 10);
+  if (msPeriod)
+    events.Schedule(telemetryTimer, msPeriod, msPeriod);
+  else
+    events.Cancel(telemetryTimer);
+}
+
+void HandleInput(char c){
+
+  if (commandType && (c == '@' || c == '#' || millis() - commandLastMs > COMMAND_IDLE_MS)){
+
+    commandLine[commandLength] = 0;
+    Serial.printf("Unfinished command dropped: %c%s\n", commandType, commandLine);
+    commandType = 0;
+  }
+  commandLastMs = millis();
+
+  if (!commandType){
+
+    if (c == '@' || c == '#'){
+      commandType   = c;
+      commandLength = 0;
+    }
+    else
+      HandleKey(c);
+    return;
+  }
+
+  if (c == '\n' || c == '\r'){
+
+    commandLine[commandLength] = 0;
+    if (commandType == '#')
+      ConfigureTelemetry(commandLine);
+    else if (automation.Load(commandLine, millis()))
+      ShowChanged();
+    else
+      Serial.printf("Bad timeline: %s\n", commandLine);
+    commandType = 0;
+  }
+  else if (commandLength < COMMAND_MAX - 1)
+    commandLine[commandLength++] = c;
+}
+
+void RecalculatePower(void *){
+
+  uint8_t target = ShowBrightness(currentSlot);
+
+  h_PowerMilliwatts = calculate_unscaled_power_mW(h_LEDs, NUM_LEDS);
+  h_MaxBrightness   = calculate_max_brightness_for_power_mW(target, h_PowerLimit);
+  if (h_MaxBrightness < target)
+    h_ThrottleEvents++;
+}
+
+//  BluetoothSerial::write queues packets and blocks the loop once its queue fills up, which is exactly what happens
+//  while the SPP link is congested.  The stack reports congestion with ESP_SPP_CONG_EVT and on every write, so keep
+//  track of it here, on the Bluetooth task, and don't drain telemetry into a link that can't take it.
+void OnSppEvent(esp_spp_cb_event_t event, esp_spp_cb_param_t * param){
+
+  switch (event){
+    case ESP_SPP_CONG_EVT:      bBTCongested = param->cong.cong;     break;
+    case ESP_SPP_WRITE_EVT:     bBTCongested = param->write.cong;    break;
+    case ESP_SPP_SRV_OPEN_EVT:
+    case ESP_SPP_CLOSE_EVT:     bBTCongested = false;                break;
+    default:                                                         break;
+  }
+}
+
+void SendTelemetry(void *){
+
+  TelemetryRecord record;
+  record.msUptime        = millis();
+  record.usFrame         = h_FrameMicros;
+  record.usShow          = h_ShowMicros;
+  record.fps             = FastLED.getFPS();
+  record.powerMilliwatts = h_PowerMilliwatts;
+  record.brightness      = h_MaxBrightness;
+  record.throttleEvents  = h_ThrottleEvents;
+  record.freeHeap        = ESP.getFreeHeap();
+  record.effect          = currentSlot.pEffect ? currentSlot.pEffect->key : 0;
+  telemetry.Record(record);
+
+  //  Only as much as fits without waiting: the UART's free FIFO space, or one packet while the SPP link isn't congested
+  //  Drain sends whole records, so the stats line DrawStats prints on Serial falls between two records, never inside one
+  if (bTelemetryBT)
+    telemetry.Drain(ESP_BT, ESP_BT.hasClient() && !bBTCongested ? TELEMETRY_BT_CHUNK : 0);
+  else
+    telemetry.Drain(Serial, Serial.availableForWrite());
+}
+
+void DrawStats(void *){
+
+  h_oled.clearBuffer();
+  h_oled.setCursor(0, h_lineHeight);
+  h_oled.printf("FPS: %.u", FastLED.getFPS());                              //  calculate frames per second
+  h_oled.setCursor(0, h_lineHeight * 2);
+  h_oled.printf("Power: %u mW", h_PowerMilliwatts);
+  h_oled.setCursor(0, h_lineHeight * 3);
+  h_oled.printf("Bright: %d", h_MaxBrightness);
+  h_oled.setCursor(0, h_lineHeight * 4);
+  h_oled.printf("CPU %u%% %u/s", events.Utilization(), events.WakeupsPerSecond());     //  busy time and wakeups of the loop
+  h_oled.sendBuffer();
+
+  Serial.printf("Blend %lu us, FFT %lu us, Quantize %lu us, Fire2D %lu us, Params %lu us (%u), CPU %u%%, %u wakeups/s, %u input dropped\n",
+                transition.LastBlendMicros(), audio.LastAnalysisMicros(), cometBuffer.LastQuantizeMicros(),
+                matrixFire.LastFrameMicros(), automation.LastEvaluateMicros(), automation.TrackCount(),
+                events.Utilization(), events.WakeupsPerSecond(), h_InputDropped);
+}
 
 void setup() {
 
@@ -88,107 +444,71 @@ void setup() {
   pinMode(LED_PIN, OUTPUT);
 
   Serial.begin(115200);
+  if (!events.Begin()){                                                    //  the input buffer comes off the heap
+
+    Serial.printf("No room for a %u byte input buffer, trying %u\n", EVENT_INPUT_BYTES, EVENT_MIN_INPUT_BYTES);
+    if (!events.Begin(EVENT_MIN_INPUT_BYTES))
+      Serial.println("No input buffer: effects run, Bluetooth input is ignored");
+  }
+  IndexEffects();
+  currentSlot.timer  = WheelTimer(DrawSlot, &currentSlot);
+  outgoingSlot.timer = WheelTimer(DrawSlot, &outgoingSlot);
+  composeTimer       = WheelTimer(ComposeTransition);
+  statsTimer         = WheelTimer(DrawStats);
+  powerTimer         = WheelTimer(RecalculatePower);
+  telemetryTimer     = WheelTimer(SendTelemetry);
+  saveTimer          = WheelTimer(SaveShow);
+
+  //  Strip first, so the saved show is lit before the Bluetooth stack, the OLED and the audio input are brought up
+
+  FastLED.addLeds<WS2812B, LED_PIN, GRB>(h_LEDs, NUM_LEDS);               //  Add our LED strip to the FastLED library
+  FastLED.setBrightness(h_Brightness);
+  set_max_power_indicator_LED(LED_BUILTIN);                               //  Light the builtin LED if we power throttle
+  FastLED.setMaxPowerInMilliWatts(h_PowerLimit);                          //  Set the power limit, above which brightness will be throttled
+  FastLED.clear();
+
+  MakeStripCoords(layoutCoords, NUM_LEDS);
+  layout.Load(layoutCoords);
+
+  RegisterParameters(automation);
+
+  const LedEffect * pSaved = RestoreShow();
+  if (pSaved){
+
+    currentSlot.pEffect = pSaved;
+    DrawSlot(&currentSlot);                                               //  first frame now, then at its own pace from the loop
+    h_FirstFrameMicros = micros();
+    if (pSaved->msPerFrame != STATIC_EFFECT)
+      StartSlot(events, currentSlot, pSaved, pSaved->msPerFrame);
+  }
+
+  ESP_BT.register_callback(OnSppEvent);
   ESP_BT.begin("LED_Light_Show");
-  while (!Serial){}
+  ESP_BT.onData([](const uint8_t * buffer, size_t size){                 //  runs on the Bluetooth task; just hand the bytes over
+    h_InputDropped += size - events.PostInput(buffer, size);
+  });
   Serial.println("ESP32 Startup");
+  if (pSaved)
+    Serial.printf("Restored '%c' %s, first frame %lu us after boot\n", pSaved->key, pSaved->name, h_FirstFrameMicros);
 
   h_oled.begin();
   h_oled.clear();
   h_oled.setFont(u8g2_font_profont15_tf);
   h_lineHeight = h_oled.getFontAscent() - h_oled.getFontDescent();        //  Descent is a negative number so we add it to the total
 
-  FastLED.addLeds<WS2812B, LED_PIN, GRB>(h_LEDs, NUM_LEDS);               //  Add our LED strip to the FastLED library
-  FastLED.setBrightness(h_Brightness);
-  set_max_power_indicator_LED(LED_BUILTIN);                               //  Light the builtin LED if we power throttle
-  FastLED.setMaxPowerInMilliWatts(h_PowerLimit);                          //  Set the power limit, above which brightness will be throttled
-  FastLED.clear();
+  if (!audio.Begin())
+    Serial.println("Audio input unavailable");
 
 }
 
 void loop() {
 
-  // Set LED pin state
-  // bool bLED = 0;
-  // double fps = 0;  // dpericated
-
-  uint8_t initialHue = 0;
-  const uint8_t deltaHue = 16;
-  const uint8_t hueDensity = 4;
-
-  while (true){
-    
-    // bLED = !bLED;                                                           //  Toggles the LED state for each frame
-    // digitalWrite(LED_BUILTIN, bLED);
-
-    // double dStart = millis() / 1000.0;                                      //  Record the start time -> depricated by FastLED.getFPS method
-    
-    //  Handle OLED drawing
-
-    // static unsigned long msLastUpdate = millis();                          //  depcicated by EVERY_N_MILLISECONDS
-    // if (millis() - msLastUpdate > 250)
-  
-    EVERY_N_MILLISECONDS(250){
-      
-      h_oled.clearBuffer();
-      h_oled.setCursor(0, h_lineHeight);
-      // h_oled.printf("FPS: %.1lf", fps);
-      h_oled.printf("FPS: %.u", FastLED.getFPS());                              //  calculate frames per second
-      h_oled.setCursor(0, h_lineHeight * 2);
-      // h_oled.printf("Power: %u mW", milliwatts);
-      h_oled.printf("Power: %u mW", calculate_unscaled_power_mW(h_LEDs, NUM_LEDS));
-      h_oled.setCursor(0, h_lineHeight * 3);
-      h_oled.printf("Bright: %d", calculate_max_brightness_for_power_mW(h_Brightness, h_PowerLimit));
-      h_oled.sendBuffer();
-      // msLastUpdate = millis();  // depricated
-    }
-  
-  //----------------------------------------------------------------------------------------------------
-    // LED strip patern functions
-    // uncomment the effect to use
-    // This system works  for all functions 
-
-    // EVERY_N_MILLISECONDS(20){ DrawMarqueeComparison(); }  // see annotations in marquee.h for options
-    // balls.Draw();                                         //  Bouncing balls using BouncingBallEffect from bounce.h; comment out to use different effect
-    // DrawComet();
-    // DrawCometGfx();
-    // DrawComet3();
-    // DrawMarquee();
-    // DrawPixels(h_Leds, NUM_LEDS, CRGB::Green);
-    // DrawTwinkle();
-    // fill_solid(h_LEDs, NUM_LEDS, CRGB::Green);
-    // fill_rainbow(h_LEDs, NUM_LEDS, initialHue += hueDensity, deltaHue);
-    // h_LEDs[0] = CRGB::Red;   // light LED 0
-    // lightFullStrip();
-    // MyFire();
-    // MyIceFire();
-    // UkrainFlag();
-
-    // this system only works for the static (single iteration) functions.
-    char btRead = ESP_BT.read();
-    if (btRead == 'a') DrawComet();                                         // dynamic
-    if (btRead == 'b') DrawCometGfx();                                      // dynamic
-    if (btRead == 'c') DrawComet3();                                        // dynamic
-    if (btRead == 'd') balls.Draw();                                        // dynamic
-    if (btRead == 'e') DrawMarquee();                                       // dynamic
-    if (btRead == 'f') DrawPixels(h_LEDs[0], NUM_LEDS, CRGB::Green);        // static
-    if (btRead == 'g') DrawTwinkle();                                       // dynamic
-    if (btRead == 'h') fill_solid(h_LEDs, NUM_LEDS, CRGB::Green);           // static
-    if (btRead == 'i') DrawTwinkleOne();                                    // dynamic
-    if (btRead == 'j') h_LEDs[0] = CRGB::Red;                               // static
-    if (btRead == 'k') lightFullStrip();                                    // static
-    if (btRead == 'l') MyFire();                                            // dynamic
-    if (btRead == 'm') MyIceFire();                                         // dynamic
-    if (btRead == 'n') UkrainFlag();                                        // static
-    if (btRead == 'o') FastLED.clear();                                     // sets all to HIGH / OFF / 0
-
-  //----------------------------------------------------------------------------------------------------
-
-    FastLED.setBrightness(h_Brightness);
-    FastLED.delay(10);                                    // Show and delay
-
-    // double dEnd = millis() / 1000.0;                    //  Record the completion time
-    // fps = FramesPerSecond(dEnd - dStart);               //  Calculate the FPS rate
-  
-  }
+  //  Sleep, running timers as they come due, until a key arrives; with a static effect up there are no timers at all
+
+  LoopEvent event;
+  events.Wait(event);
 
-}
\ No newline at end of file
+  if (event.type == InputEvent)
+    HandleInput(event.key);
+
+}
@@ -0,0 +1,222 @@
+//+--------------------------------------------------------------------------
+//
+// File:        Arduino.h
+//
+// Description:
+//
+//      Host stand-in for the parts of the Arduino core that the headers in
+//      include/ use, for the native test environment.  Time comes from a
+//      simulated clock that the tests move by hand, and random() is a fixed
+//      LCG, so every run draws exactly the same frames.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+#include <algorithm>
+
+#include <sys/time.h>
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+using std::min;
+using std::max;
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#define OUTPUT          1
+#define LED_BUILTIN     25
+
+inline void pinMode(int, int)       {}
+inline void digitalWrite(int, int)  {}
+inline void yield()                 {}
+
+// Simulated clock
+//
+// Free running microseconds since "boot".  millis() and micros() wrap at 32 bits like they do on
+// the ESP32, and gettimeofday (see sys/time.h here) reads the same clock.
+
+inline uint64_t & SimClockMicros()
+{
+    static uint64_t usNow = 0;
+    return usNow;
+}
+
+inline void SimAdvanceMicros(uint64_t us)
+{
+    SimClockMicros() += us;
+}
+
+inline void SimAdvanceMillis(uint64_t ms)
+{
+    SimClockMicros() += ms * 1000;
+}
+
+inline unsigned long micros()
+{
+    return (uint32_t) SimClockMicros();
+}
+
+inline unsigned long millis()
+{
+    return (uint32_t)(SimClockMicros() / 1000);
+}
+
+inline void delay(unsigned long ms)
+{
+    SimAdvanceMillis(ms);
+}
+
+inline int SimGetTimeOfDay(struct timeval * tv, void *)
+{
+    tv->tv_sec  = (time_t)(SimClockMicros() / 1000000);
+    tv->tv_usec = (suseconds_t)(SimClockMicros() % 1000000);
+    return 0;
+}
+
+// Seeded random()
+//
+// The ESP32 core takes random() from the hardware RNG; here it is a 32-bit LCG that randomSeed()
+// resets, with the low bits thrown away because they repeat quickly
+
+inline uint32_t & SimRandomState()
+{
+    static uint32_t state = 1;
+    return state;
+}
+
+inline void randomSeed(unsigned long seed)
+{
+    SimRandomState() = (uint32_t) seed;
+}
+
+inline long random(long howbig)
+{
+    if (howbig <= 0)
+        return 0;
+
+    uint32_t & state = SimRandomState();
+    state = state * 1664525UL + 1013904223UL;
+    return (long)((state >> 8) % (uint32_t) howbig);
+}
+
+inline long random(long howsmall, long howbig)
+{
+    return howsmall < howbig ? howsmall + random(howbig - howsmall) : howsmall;
+}
+
+inline uint32_t esp_random()
+{
+    return (uint32_t) random(0x7FFFFFFFL);
+}
+
+// Print and Stream
+//
+// Same shape as the core's: derived classes implement write(uint8_t) and may take whole buffers
+
+class Print
+{
+  public:
+
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+
+    virtual size_t write(const uint8_t * buffer, size_t size)
+    {
+        size_t n = 0;
+        while (size-- && write(*buffer++))
+            n++;
+        return n;
+    }
+
+    virtual int availableForWrite()
+    {
+        return 0;
+    }
+
+    size_t print(const char * text)
+    {
+        return write((const uint8_t *) text, strlen(text));
+    }
+
+    size_t println(const char * text = "")
+    {
+        return print(text) + print("\r\n");
+    }
+
+    size_t printf(const char * format, ...) __attribute__((format(printf, 2, 3)))
+    {
+        char    buffer[256];
+        va_list args;
+
+        va_start(args, format);
+        int length = vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+
+        return length > 0 ? write((const uint8_t *) buffer, min((size_t) length, sizeof(buffer) - 1)) : 0;
+    }
+};
+
+class Stream : public Print
+{
+  public:
+
+    virtual int available()
+    {
+        return 0;
+    }
+
+    virtual int read()
+    {
+        return -1;
+    }
+};
+
+// Serial goes to stdout, and its transmit FIFO never fills
+
+class HardwareSerial : public Stream
+{
+  public:
+
+    using Print::write;
+
+    void begin(unsigned long) {}
+
+    size_t write(uint8_t c) override
+    {
+        return fputc(c, stdout) == EOF ? 0 : 1;
+    }
+
+    int availableForWrite() override
+    {
+        return 128;
+    }
+
+    operator bool() const
+    {
+        return true;
+    }
+};
+
+static HardwareSerial Serial;
+
+struct EspClass
+{
+    uint32_t getFreeHeap()
+    {
+        return 200000;
+    }
+};
+
+static EspClass ESP;
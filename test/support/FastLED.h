@@ -0,0 +1,647 @@
+//+--------------------------------------------------------------------------
+//
+// File:        FastLED.h
+//
+// Description:
+//
+//      Host stand-in for the parts of FastLED 3.5 that the effects use, for
+//      the native test environment.  The color math, random numbers, waves
+//      and palettes follow FastLED's own C implementations so frames drawn
+//      here match the strip; show() only counts frames.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+
+typedef uint8_t  fract8;
+typedef uint16_t fract16;
+typedef uint16_t accum88;
+
+// Scaling, with FASTLED_SCALE8_FIXED so that scale8(x, 255) == x
+
+inline uint8_t scale8(uint8_t i, fract8 scale)
+{
+    return ((uint16_t) i * (1 + (uint16_t) scale)) >> 8;
+}
+
+inline uint8_t scale8_video(uint8_t i, fract8 scale)
+{
+    return (((int) i * (int) scale) >> 8) + ((i && scale) ? 1 : 0);
+}
+
+inline uint16_t scale16(uint16_t i, fract16 scale)
+{
+    return ((uint32_t) i * (1 + (uint32_t) scale)) >> 16;
+}
+
+inline uint8_t qadd8(uint8_t i, uint8_t j)
+{
+    unsigned t = i + j;
+    return t > 255 ? 255 : t;
+}
+
+inline uint8_t qsub8(uint8_t i, uint8_t j)
+{
+    int t = i - j;
+    return t < 0 ? 0 : t;
+}
+
+inline uint8_t ease8InOutQuad(uint8_t i)
+{
+    uint8_t j = i;
+    if (j & 0x80)
+        j = 255 - j;
+    uint8_t jj  = scale8(j, j);
+    uint8_t jj2 = jj << 1;
+    if (i & 0x80)
+        jj2 = 255 - jj2;
+    return jj2;
+}
+
+// Random numbers, FastLED's 16-bit LCG
+
+#define RAND16_SEED     1337
+
+inline uint16_t & Rand16Seed()
+{
+    static uint16_t seed = RAND16_SEED;
+    return seed;
+}
+
+inline uint8_t random8()
+{
+    Rand16Seed() = Rand16Seed() * 2053 + 13849;
+    return (uint8_t)((uint8_t)(Rand16Seed() & 0xFF) + (uint8_t)(Rand16Seed() >> 8));
+}
+
+inline uint8_t random8(uint8_t lim)
+{
+    return (random8() * lim) >> 8;
+}
+
+inline uint8_t random8(uint8_t min, uint8_t lim)
+{
+    return random8(lim - min) + min;
+}
+
+inline uint16_t random16()
+{
+    Rand16Seed() = Rand16Seed() * 2053 + 13849;
+    return Rand16Seed();
+}
+
+inline uint16_t random16(uint16_t lim)
+{
+    return ((uint32_t) random16() * lim) >> 16;
+}
+
+inline uint16_t random16(uint16_t min, uint16_t lim)
+{
+    return random16(lim - min) + min;
+}
+
+inline void     random16_set_seed(uint16_t seed)    { Rand16Seed() = seed; }
+inline uint16_t random16_get_seed()                 { return Rand16Seed(); }
+inline void     random16_add_entropy(uint16_t e)    { Rand16Seed() += e; }
+
+// Waves, sin8_C and sin16_C
+
+inline uint8_t sin8(uint8_t theta)
+{
+    static const uint8_t b_m16_interleave[] = { 0, 49, 49, 41, 90, 27, 117, 10 };
+
+    uint8_t offset = theta;
+    if (theta & 0x40)
+        offset = (uint8_t) 255 - offset;
+    offset &= 0x3F;
+
+    uint8_t secoffset = offset & 0x0F;
+    if (theta & 0x40)
+        secoffset++;
+
+    const uint8_t * p = b_m16_interleave + (offset >> 4) * 2;
+    uint8_t b   = p[0];
+    uint8_t m16 = p[1];
+    uint8_t mx  = (m16 * secoffset) >> 4;
+
+    int8_t y = mx + b;
+    if (theta & 0x80)
+        y = -y;
+    return (uint8_t)(y + 128);
+}
+
+inline uint8_t cos8(uint8_t theta)
+{
+    return sin8(theta + 64);
+}
+
+inline int16_t sin16(uint16_t theta)
+{
+    static const uint16_t base[]  = { 0, 6393, 12539, 18204, 23170, 27245, 30273, 32137 };
+    static const uint8_t  slope[] = { 49, 48, 44, 38, 31, 23, 14, 4 };
+
+    uint16_t offset = (theta & 0x3FFF) >> 3;
+    if (theta & 0x4000)
+        offset = 2047 - offset;
+
+    uint8_t  section    = offset / 256;
+    uint8_t  secoffset8 = (uint8_t) offset / 2;
+    uint16_t mx         = slope[section] * secoffset8;
+
+    int16_t y = mx + base[section];
+    if (theta & 0x8000)
+        y = -y;
+    return y;
+}
+
+inline int16_t cos16(uint16_t theta)
+{
+    return sin16(theta + 16384);
+}
+
+inline uint16_t beat88(accum88 bpm88, uint32_t timebase = 0)
+{
+    return ((millis() - timebase) * bpm88 * 280) >> 16;
+}
+
+inline uint16_t beat16(accum88 bpm, uint32_t timebase = 0)
+{
+    if (bpm < 256)
+        bpm <<= 8;
+    return beat88(bpm, timebase);
+}
+
+inline uint8_t beat8(accum88 bpm, uint32_t timebase = 0)
+{
+    return beat16(bpm, timebase) >> 8;
+}
+
+inline uint16_t beatsin16(accum88 bpm, uint16_t lowest = 0, uint16_t highest = 65535, uint32_t timebase = 0, uint16_t phase = 0)
+{
+    uint16_t beatsin = sin16(beat16(bpm, timebase) + phase) + 32768;
+    return lowest + scale16(beatsin, highest - lowest);
+}
+
+inline uint8_t beatsin8(accum88 bpm, uint8_t lowest = 0, uint8_t highest = 255, uint32_t timebase = 0, uint8_t phase = 0)
+{
+    uint8_t beatsin = sin8(beat8(bpm, timebase) + phase);
+    return lowest + scale8(beatsin, highest - lowest);
+}
+
+// Colors
+
+enum HSVHue
+{
+    HUE_RED     = 0,
+    HUE_ORANGE  = 32,
+    HUE_YELLOW  = 64,
+    HUE_GREEN   = 96,
+    HUE_AQUA    = 128,
+    HUE_BLUE    = 160,
+    HUE_PURPLE  = 192,
+    HUE_PINK    = 224
+};
+
+struct CHSV
+{
+    union
+    {
+        struct { uint8_t hue, sat, val; };
+        struct { uint8_t h, s, v; };
+        uint8_t raw[3];
+    };
+
+    CHSV() : hue(0), sat(0), val(0) {}
+    CHSV(uint8_t ih, uint8_t is, uint8_t iv) : hue(ih), sat(is), val(iv) {}
+};
+
+struct CRGB;
+void hsv2rgb_rainbow(const CHSV & hsv, CRGB & rgb);
+
+struct CRGB
+{
+    union
+    {
+        struct { uint8_t r, g, b; };
+        struct { uint8_t red, green, blue; };
+        uint8_t raw[3];
+    };
+
+    enum HTMLColorCode
+    {
+        Black   = 0x000000,
+        Blue    = 0x0000FF,
+        Green   = 0x008000,
+        Purple  = 0x800080,
+        Red     = 0xFF0000,
+        White   = 0xFFFFFF,
+        Yellow  = 0xFFFF00
+    };
+
+    CRGB() : r(0), g(0), b(0) {}
+    CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+    CRGB(uint32_t colorcode) : r(colorcode >> 16), g(colorcode >> 8), b(colorcode) {}
+    CRGB(HTMLColorCode colorcode) : r(colorcode >> 16), g(colorcode >> 8), b(colorcode) {}
+    CRGB(const CHSV & hsv) { hsv2rgb_rainbow(hsv, *this); }
+
+    CRGB & operator=(const CHSV & hsv)  { hsv2rgb_rainbow(hsv, *this); return *this; }
+
+    uint8_t &       operator[](uint8_t x)        { return raw[x]; }
+    const uint8_t & operator[](uint8_t x) const  { return raw[x]; }
+
+    CRGB & setHue(uint8_t hue)
+    {
+        hsv2rgb_rainbow(CHSV(hue, 255, 255), *this);
+        return *this;
+    }
+
+    CRGB & nscale8(uint8_t scale)
+    {
+        r = scale8(r, scale);
+        g = scale8(g, scale);
+        b = scale8(b, scale);
+        return *this;
+    }
+
+    CRGB & nscale8_video(uint8_t scale)
+    {
+        r = scale8_video(r, scale);
+        g = scale8_video(g, scale);
+        b = scale8_video(b, scale);
+        return *this;
+    }
+
+    CRGB & fadeToBlackBy(uint8_t fadefactor)
+    {
+        return nscale8(255 - fadefactor);
+    }
+
+    CRGB & operator+=(const CRGB & rhs)
+    {
+        r = qadd8(r, rhs.r);
+        g = qadd8(g, rhs.g);
+        b = qadd8(b, rhs.b);
+        return *this;
+    }
+
+    operator bool() const
+    {
+        return r || g || b;
+    }
+};
+
+inline bool operator==(const CRGB & lhs, const CRGB & rhs)
+{
+    return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b;
+}
+
+inline bool operator!=(const CRGB & lhs, const CRGB & rhs)
+{
+    return !(lhs == rhs);
+}
+
+inline CRGB operator+(const CRGB & lhs, const CRGB & rhs)
+{
+    CRGB sum = lhs;
+    return sum += rhs;
+}
+
+// hsv2rgb_rainbow
+//
+// FastLED's C version with its default yellow and green balance (Y1 on, Y2, G2 and Gscale off)
+
+inline void hsv2rgb_rainbow(const CHSV & hsv, CRGB & rgb)
+{
+    uint8_t hue = hsv.hue;
+    uint8_t sat = hsv.sat;
+    uint8_t val = hsv.val;
+
+    uint8_t offset8 = (hue & 0x1F) << 3;
+    uint8_t third   = scale8(offset8, 256 / 3);
+    uint8_t r, g, b;
+
+    if (!(hue & 0x80))
+    {
+        if (!(hue & 0x40))
+        {
+            if (!(hue & 0x20))
+            {
+                r = 255 - third; g = third;      b = 0;                 //  red to orange
+            }
+            else
+            {
+                r = 171;         g = 85 + third; b = 0;                 //  orange to yellow
+            }
+        }
+        else
+        {
+            if (!(hue & 0x20))
+            {
+                uint8_t twothirds = scale8(offset8, (256 * 2) / 3);
+                r = 171 - twothirds; g = 170 + third; b = 0;            //  yellow to green
+            }
+            else
+            {
+                r = 0; g = 255 - third; b = third;                      //  green to aqua
+            }
+        }
+    }
+    else
+    {
+        if (!(hue & 0x40))
+        {
+            if (!(hue & 0x20))
+            {
+                uint8_t twothirds = scale8(offset8, (256 * 2) / 3);
+                r = 0; g = 171 - twothirds; b = 85 + twothirds;         //  aqua to blue
+            }
+            else
+            {
+                r = third; g = 0; b = 255 - third;                      //  blue to purple
+            }
+        }
+        else
+        {
+            if (!(hue & 0x20))
+            {
+                r = 85 + third;  g = 0; b = 171 - third;                //  purple to pink
+            }
+            else
+            {
+                r = 170 + third; g = 0; b = 85 - third;                 //  pink to red
+            }
+        }
+    }
+
+    if (sat != 255)
+    {
+        if (sat == 0)
+        {
+            r = g = b = 255;
+        }
+        else
+        {
+            uint8_t desat    = scale8_video(255 - sat, 255 - sat);
+            uint8_t satscale = 255 - desat;
+
+            if (r) r = scale8(r, satscale) + 1;
+            if (g) g = scale8(g, satscale) + 1;
+            if (b) b = scale8(b, satscale) + 1;
+
+            r += desat;
+            g += desat;
+            b += desat;
+        }
+    }
+
+    if (val != 255)
+    {
+        val = scale8_video(val, val);
+        if (val == 0)
+        {
+            r = g = b = 0;
+        }
+        else
+        {
+            if (r) r = scale8(r, val) + 1;
+            if (g) g = scale8(g, val) + 1;
+            if (b) b = scale8(b, val) + 1;
+        }
+    }
+
+    rgb.r = r;
+    rgb.g = g;
+    rgb.b = b;
+}
+
+inline CRGB HeatColor(uint8_t temperature)
+{
+    uint8_t t192     = scale8_video(temperature, 191);
+    uint8_t heatramp = (t192 & 0x3F) << 2;
+
+    if (t192 & 0x80)
+        return CRGB(255, 255, heatramp);
+    if (t192 & 0x40)
+        return CRGB(255, heatramp, 0);
+    return CRGB(heatramp, 0, 0);
+}
+
+// IceColor
+//
+// HeatColor with red and blue swapped, black through blue and cyan to white
+
+inline CRGB IceColor(uint8_t temperature)
+{
+    CRGB heat = HeatColor(temperature);
+    return CRGB(heat.b, heat.g, heat.r);
+}
+
+inline void fill_solid(CRGB * leds, int numToFill, const CRGB & color)
+{
+    for (int i = 0; i < numToFill; i++)
+        leds[i] = color;
+}
+
+inline void fill_rainbow(CRGB * leds, int numToFill, uint8_t initialhue, uint8_t deltahue = 5)
+{
+    CHSV hsv(initialhue, 240, 255);
+    for (int i = 0; i < numToFill; i++, hsv.hue += deltahue)
+        leds[i] = hsv;
+}
+
+inline void nscale8(CRGB * leds, uint16_t num_leds, uint8_t scale)
+{
+    for (uint16_t i = 0; i < num_leds; i++)
+        leds[i].nscale8(scale);
+}
+
+inline void fadeToBlackBy(CRGB * leds, uint16_t num_leds, uint8_t fadeBy)
+{
+    nscale8(leds, num_leds, 255 - fadeBy);
+}
+
+// Palettes
+
+typedef const uint8_t   TProgmemRGBGradientPalette_byte;
+typedef const uint8_t * TProgmemRGBGradientPalette_bytes;
+
+#define DEFINE_GRADIENT_PALETTE(X) extern const TProgmemRGBGradientPalette_byte X[] =
+
+enum TBlendType
+{
+    NOBLEND     = 0,
+    LINEARBLEND = 1
+};
+
+inline void fill_gradient_RGB(CRGB * leds, uint16_t startpos, CRGB startcolor, uint16_t endpos, CRGB endcolor)
+{
+    if (endpos < startpos)
+    {
+        std::swap(startpos, endpos);
+        std::swap(startcolor, endcolor);
+    }
+
+    int16_t  pixeldistance = endpos - startpos;
+    int16_t  divisor       = pixeldistance ? pixeldistance : 1;
+    int32_t  rdelta87      = (int32_t)(((int16_t) endcolor.r - startcolor.r) << 7) / divisor * 2;
+    int32_t  gdelta87      = (int32_t)(((int16_t) endcolor.g - startcolor.g) << 7) / divisor * 2;
+    int32_t  bdelta87      = (int32_t)(((int16_t) endcolor.b - startcolor.b) << 7) / divisor * 2;
+    uint16_t r88           = startcolor.r << 8;
+    uint16_t g88           = startcolor.g << 8;
+    uint16_t b88           = startcolor.b << 8;
+
+    for (uint16_t i = startpos; i <= endpos; i++)
+    {
+        leds[i] = CRGB(r88 >> 8, g88 >> 8, b88 >> 8);
+        r88 += rdelta87;
+        g88 += gdelta87;
+        b88 += bdelta87;
+    }
+}
+
+struct CRGBPalette16
+{
+    CRGB entries[16];
+
+    CRGBPalette16() {}
+
+    // Converts a gradient palette of { index, r, g, b } entries ending at index 255
+
+    CRGBPalette16(TProgmemRGBGradientPalette_bytes progpal)
+    {
+        int count = 0;
+        while (progpal[count * 4] != 255)
+            count++;
+        count++;
+
+        CRGB rgbstart(progpal[1], progpal[2], progpal[3]);
+        int  indexstart   = 0;
+        int  lastSlotUsed = -1;
+
+        for (int entry = 1; indexstart < 255; entry++)
+        {
+            const uint8_t * p = progpal + entry * 4;
+            int  indexend = p[0];
+            CRGB rgbend(p[1], p[2], p[3]);
+
+            int istart8 = indexstart / 16;
+            int iend8   = indexend / 16;
+            if (count < 16 && istart8 <= lastSlotUsed && lastSlotUsed < 15)
+            {
+                istart8 = lastSlotUsed + 1;
+                if (iend8 < istart8)
+                    iend8 = istart8;
+            }
+            lastSlotUsed = iend8;
+
+            fill_gradient_RGB(entries, istart8, rgbstart, iend8, rgbend);
+            indexstart = indexend;
+            rgbstart   = rgbend;
+        }
+    }
+
+    CRGB &       operator[](uint8_t x)        { return entries[x]; }
+    const CRGB & operator[](uint8_t x) const  { return entries[x]; }
+};
+
+inline CRGB ColorFromPalette(const CRGBPalette16 & pal, uint8_t index, uint8_t brightness = 255, TBlendType blendType = LINEARBLEND)
+{
+    uint8_t hi4 = index >> 4;
+    uint8_t lo4 = index & 0x0F;
+    CRGB    color = pal[hi4];
+
+    if (lo4 && blendType != NOBLEND)
+    {
+        const CRGB & next = pal[(hi4 + 1) & 0x0F];
+        uint8_t f2 = lo4 << 4;
+        uint8_t f1 = 255 - f2;
+
+        color.r = scale8(color.r, f1) + scale8(next.r, f2);
+        color.g = scale8(color.g, f1) + scale8(next.g, f2);
+        color.b = scale8(color.b, f1) + scale8(next.b, f2);
+    }
+
+    if (brightness != 255)
+        color.nscale8_video(brightness);
+    return color;
+}
+
+// Controller
+//
+// Holds the frame buffer registered with addLeds; show() counts frames and remembers its scale
+
+enum EOrder { RGB = 0012, GRB = 0102 };
+
+class CFastLED
+{
+  protected:
+
+    CRGB *      _leds        = nullptr;
+    int         _count       = 0;
+    uint8_t     _brightness  = 255;
+    uint8_t     _lastScale   = 255;
+    uint32_t    _maxPower    = 0;
+    uint32_t    _frames      = 0;
+
+  public:
+
+    void addLeds(CRGB * leds, int count)
+    {
+        _leds  = leds;
+        _count = count;
+    }
+
+    void     setBrightness(uint8_t scale)           { _brightness = scale; }
+    uint8_t  getBrightness() const                  { return _brightness; }
+    void     setMaxPowerInMilliWatts(uint32_t mW)   { _maxPower = mW; }
+    uint16_t getFPS() const                         { return 0; }
+
+    void show(uint8_t scale)
+    {
+        _lastScale = scale;
+        _frames++;
+    }
+
+    void show()
+    {
+        show(_brightness);
+    }
+
+    void clear(bool = false)
+    {
+        if (_leds)
+            memset((void *) _leds, 0, _count * sizeof(CRGB));
+    }
+
+    CRGB *   leds()                 { return _leds; }
+    int      size() const           { return _count; }
+    int      count() const          { return _count; }
+    uint32_t FramesShown() const    { return _frames; }
+    uint8_t  LastShowScale() const  { return _lastScale; }
+};
+
+static CFastLED FastLED;
+
+inline void set_max_power_indicator_LED(uint8_t) {}
+
+inline uint32_t calculate_unscaled_power_mW(const CRGB * leds, uint16_t numLeds)
+{
+    uint32_t red = 0, green = 0, blue = 0;
+    for (uint16_t i = 0; i < numLeds; i++)
+    {
+        red   += leds[i].r;
+        green += leds[i].g;
+        blue  += leds[i].b;
+    }
+    return ((red * 80) >> 8) + ((green * 55) >> 8) + ((blue * 75) >> 8) + numLeds * 5;
+}
+
+inline uint8_t calculate_max_brightness_for_power_mW(uint8_t target_brightness, uint32_t max_power_mW)
+{
+    uint32_t requested = calculate_unscaled_power_mW(FastLED.leds(), FastLED.count()) * target_brightness / 256;
+    return requested > max_power_mW ? target_brightness * max_power_mW / requested : target_brightness;
+}
@@ -0,0 +1,125 @@
+//+--------------------------------------------------------------------------
+//
+// File:        Preferences.h
+//
+// Description:
+//
+//      Host stand-in for the ESP32 core's Preferences, with NVS replaced by
+//      files: each namespace is a directory under SimFlashDirectory() and
+//      each key a file in it, so a test can save, "reboot" with fresh
+//      objects and load again, or look at and damage what was stored.
+//      Only the calls the sketch makes are here, and they fail the same
+//      way the real ones do.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string>
+#include <sys/stat.h>
+
+// The directory standing in for the flash partition; set it before the first begin()
+
+inline std::string & SimFlashDirectory()
+{
+    static std::string directory = "flash";
+    return directory;
+}
+
+class Preferences
+{
+  protected:
+
+    std::string _namespace;
+    bool        _bReadOnly;
+    bool        _bOpen;
+
+    std::string Path(const char * key) const
+    {
+        return _namespace + "/" + key;
+    }
+
+  public:
+
+    Preferences()
+      : _bReadOnly(true),
+        _bOpen(false)
+    {
+    }
+
+    // begin
+    //
+    // Like nvs_open, read only fails when the namespace has never been written
+
+    bool begin(const char * name, bool readOnly = false)
+    {
+        struct stat info;
+
+        _namespace = SimFlashDirectory() + "/" + name;
+        if (stat(_namespace.c_str(), &info) != 0)
+        {
+            if (readOnly)
+                return false;
+            mkdir(SimFlashDirectory().c_str(), 0755);
+            if (mkdir(_namespace.c_str(), 0755) != 0)
+                return false;
+        }
+
+        _bReadOnly = readOnly;
+        _bOpen     = true;
+        return true;
+    }
+
+    void end()
+    {
+        _bOpen = false;
+    }
+
+    size_t getBytesLength(const char * key)
+    {
+        struct stat info;
+        return _bOpen && stat(Path(key).c_str(), &info) == 0 ? info.st_size : 0;
+    }
+
+    // getBytes
+    //
+    // As on the device, a blob bigger than the buffer reads as nothing rather than being cut short
+
+    size_t getBytes(const char * key, void * buffer, size_t maxLength)
+    {
+        size_t length = getBytesLength(key);
+        if (length == 0 || length > maxLength)
+            return 0;
+
+        FILE * file = fopen(Path(key).c_str(), "rb");
+        if (!file)
+            return 0;
+
+        size_t read = fread(buffer, 1, length, file);
+        fclose(file);
+        return read == length ? length : 0;
+    }
+
+    size_t putBytes(const char * key, const void * value, size_t length)
+    {
+        if (!_bOpen || _bReadOnly)
+            return 0;
+
+        FILE * file = fopen(Path(key).c_str(), "wb");
+        if (!file)
+            return 0;
+
+        size_t written = fwrite(value, 1, length, file);
+        fclose(file);
+        return written == length ? length : 0;
+    }
+
+    bool remove(const char * key)
+    {
+        return _bOpen && !_bReadOnly && ::remove(Path(key).c_str()) == 0;
+    }
+};
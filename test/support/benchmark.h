@@ -0,0 +1,45 @@
+//+--------------------------------------------------------------------------
+//
+// File:        benchmark.h
+//
+// Description:
+//
+//      Wall clock timing for the host benchmarks.  micros() in the native
+//      environment is the simulated clock, so anything that measures real
+//      cost reads the host's steady clock through here instead.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+
+inline uint64_t HostNanos()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// NanosPerCall
+//
+// Runs fn 'reps' times, 'rounds' times over, and returns the best round's average.  The best round
+// rather than the mean so that a busy build machine doesn't fail a budget.
+
+template <typename Func>
+uint64_t NanosPerCall(Func fn, int reps, int rounds = 5)
+{
+    uint64_t best = UINT64_MAX;
+
+    for (int round = 0; round < rounds; round++)
+    {
+        uint64_t nsStart = HostNanos();
+        for (int i = 0; i < reps; i++)
+            fn();
+        uint64_t ns = (HostNanos() - nsStart) / reps;
+        if (ns < best)
+            best = ns;
+    }
+    return best;
+}
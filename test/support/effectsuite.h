@@ -0,0 +1,154 @@
+//+--------------------------------------------------------------------------
+//
+// File:        effectsuite.h
+//
+// Description:
+//
+//      The sketch's effect registry from effects.h, plus a runner that draws
+//      a fixed number of frames of one of them from a fixed seed on the
+//      simulated clock.  The test that includes this defines NUM_LEDS,
+//      UK_LEDS, MATRIX_WIDTH and MATRIX_HEIGHT first, just as main.cpp does.
+//
+// History:     Oct-19-2026     tomwer      Created
+//                              tomwer      Effects shared with main.cpp through effects.h
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+
+#include <unity.h>
+
+#include "benchmark.h"
+
+CRGB h_LEDs[NUM_LEDS] = {0};
+int  h_Brightness = 128;
+
+#define ARRAYSIZE(x) (sizeof(x) / sizeof(x[0]))
+
+#include "effects.h"
+
+#define SUITE_SEED          0x1D2C
+#define SUITE_STATIC_MS     20                  //  How far the clock moves between frames of a static effect
+#define SUITE_TONE_STEP     512                 //  sin16 phase per sample for 160 Hz at AUDIO_SAMPLE_RATE
+#define SUITE_BEAT_MS       500                 //  The test tone swells for 100 ms out of every 500
+
+// SetupSuite
+//
+// The parts of setup() the effects depend on
+
+void SetupSuite()
+{
+  FastLED.addLeds(h_LEDs, NUM_LEDS);
+  FastLED.clear();
+
+  MakeStripCoords(layoutCoords, NUM_LEDS);
+  layout.Load(layoutCoords);
+}
+
+// FeedTestTone
+//
+// Hands the analyzer the samples a microphone would have picked up over 'ms': a bass tone that
+// swells every SUITE_BEAT_MS, so the sound reactive effects see levels and beats
+
+void FeedTestTone(unsigned long ms)
+{
+  static uint16_t phase = 0;
+  int16_t samples[AUDIO_SAMPLE_RATE / 1000];
+
+  for (unsigned long i = 0; i < ms; i++)
+  {
+    int amplitude = (millis() + i) % SUITE_BEAT_MS < 100 ? 4 : 1;
+    for (size_t s = 0; s < ARRAYSIZE(samples); s++, phase += SUITE_TONE_STEP)
+      samples[s] = sin16(phase) / 8 * amplitude;
+    audio.AddSamples(samples, ARRAYSIZE(samples));
+  }
+}
+
+uint32_t Crc32(uint32_t crc, const void * data, size_t length)
+{
+  const uint8_t * bytes = (const uint8_t *) data;
+
+  crc = ~crc;
+  while (length--)
+  {
+    crc ^= *bytes++;
+    for (int bit = 0; bit < 8; bit++)
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+const LedEffect * FindLedEffect(char key)
+{
+  for (size_t i = 0; i < ARRAYSIZE(Effects); i++)
+    if (Effects[i].key == key)
+      return &Effects[i];
+  return nullptr;
+}
+
+// DrawFrames
+//
+// Draws 'frames' frames the way DrawSlot does, moving the clock along by the effect's frame
+// interval each time, and returns the CRC of every frame in turn.  Both random generators are
+// reseeded first, so the CRC only changes when what the effect draws changes.
+
+uint32_t DrawFrames(const LedEffect & effect, int frames)
+{
+  unsigned long msStep = effect.msPerFrame != STATIC_EFFECT ? effect.msPerFrame : SUITE_STATIC_MS;
+  uint32_t crc = 0;
+
+  randomSeed(SUITE_SEED);
+  random16_set_seed(SUITE_SEED);
+  FastLED.clear();
+
+  for (int frame = 0; frame < frames; frame++)
+  {
+    audio.Update();
+    effect.draw();
+    crc = Crc32(crc, h_LEDs, sizeof(h_LEDs));
+
+    FeedTestTone(msStep);
+    SimAdvanceMillis(msStep);
+  }
+  return crc;
+}
+
+// NanosPerFrame
+//
+// Wall clock cost of drawing one frame of an effect, without the audio analysis or the CRC
+
+uint64_t NanosPerFrame(const LedEffect & effect, int frames)
+{
+  unsigned long msStep = effect.msPerFrame != STATIC_EFFECT ? effect.msPerFrame : SUITE_STATIC_MS;
+
+  return NanosPerCall([&]{ effect.draw(); SimAdvanceMillis(msStep); }, frames);
+}
+
+// CheckFrameBudgets
+//
+// Fails if any effect takes more than EFFECT_BUDGET_NS_PER_LED per LED to draw a frame: the same
+// 2 us per LED that main.cpp's FRAME_BUDGET_US reports on the device.  The host is much faster
+// than the ESP32, so this only trips on the kind of mistake that makes an effect many times slower.
+
+#define EFFECT_BUDGET_NS_PER_LED    2000
+#define EFFECT_BUDGET_FRAMES        50
+
+void CheckFrameBudgets()
+{
+  char message[80];
+  bool bOver = false;
+
+  for (size_t i = 0; i < ARRAYSIZE(Effects); i++)
+  {
+    uint64_t ns = NanosPerFrame(Effects[i], EFFECT_BUDGET_FRAMES);
+    snprintf(message, sizeof(message), "'%c' %llu ns/frame at %d LEDs", Effects[i].key, (unsigned long long) ns, NUM_LEDS);
+    TEST_MESSAGE(message);
+
+    bOver |= ns > (uint64_t) EFFECT_BUDGET_NS_PER_LED * NUM_LEDS;
+  }
+  TEST_ASSERT_FALSE_MESSAGE(bOver, "an effect is over its frame budget");
+}
@@ -0,0 +1,131 @@
+//+--------------------------------------------------------------------------
+//
+// File:        simeventsource.h
+//
+// Description:
+//
+//      EventSource for the host tests.  Events are scripted to arrive at
+//      given times on the simulated clock, and Receive() jumps the clock to
+//      whichever comes first, the next scripted event or the timeout, so
+//      hours of loop time run in milliseconds.  Every return from Receive()
+//      is logged as a wakeup.  Timer callbacks call Work() to stand for the
+//      time they'd take on the device, so the loop's busy time and
+//      utilization come out as they would there.
+//
+// History:     Oct-19-2026     tomwer      Created
+//                              tomwer      Simulated cost per callback
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include <algorithm>
+
+#include "eventloop.h"
+
+class SimulatedEventSource : public EventSource
+{
+  protected:
+
+    struct ScriptedEvent
+    {
+      uint64_t    usAt;
+      LoopEvent   event;
+    };
+
+    std::vector<ScriptedEvent>  _script;                //  Sorted by time, next event last; ties in the order scripted
+    std::vector<uint64_t>       _wakeups;               //  Simulated time of every return from Receive
+    uint64_t                    _usPerCallback;         //  What Work() moves the clock on by
+
+  public:
+
+    SimulatedEventSource(uint64_t usPerCallback = 0)
+      : _usPerCallback(usPerCallback)
+    {
+    }
+
+    bool Begin(size_t) override
+    {
+      return true;
+    }
+
+    unsigned long Millis() override
+    {
+      return millis();
+    }
+
+    unsigned long Micros() override
+    {
+      return micros();
+    }
+
+    // PostInput
+    //
+    // The bytes arrive now, in order, and there is always room for them
+
+    size_t PostInput(const uint8_t * bytes, size_t count) override
+    {
+      for (size_t i = 0; i < count; i++)
+        Script(0, { InputEvent, (char) bytes[i] });
+      return count;
+    }
+
+    // Script
+    //
+    // Has 'event' arrive msFromNow after the current simulated time
+
+    void Script(uint64_t msFromNow, const LoopEvent & event)
+    {
+      ScriptedEvent scripted = { SimClockMicros() + msFromNow * 1000, event };
+
+      auto at = std::lower_bound(_script.begin(), _script.end(), scripted, [](const ScriptedEvent & a, const ScriptedEvent & b)
+      {
+        return a.usAt > b.usAt;
+      });
+      _script.insert(at, scripted);
+    }
+
+    // Receive
+    //
+    // Waiting forever with nothing left in the script would hang the real loop; here it jumps
+    // the clock a day ahead and returns empty handed so the test can see it happened.
+
+    bool Receive(LoopEvent & event, uint32_t msTimeout) override
+    {
+      uint64_t usDeadline = SimClockMicros() + (msTimeout == EVENT_WAIT_FOREVER ? 86400000000ULL : msTimeout * 1000ULL);
+      bool     bEvent     = !_script.empty() && _script.back().usAt <= usDeadline;
+
+      if (bEvent)
+      {
+        SimClockMicros() = max(SimClockMicros(), _script.back().usAt);
+        event = _script.back().event;
+        _script.pop_back();
+      }
+      else
+        SimClockMicros() = usDeadline;
+
+      _wakeups.push_back(SimClockMicros());
+      return bEvent;
+    }
+
+    // Work
+    //
+    // Called by a timer callback to spend its simulated cost; the clock moves on with the loop awake
+
+    void Work()
+    {
+      SimAdvanceMicros(_usPerCallback);
+    }
+
+    bool ScriptDone() const
+    {
+      return _script.empty();
+    }
+
+    const std::vector<uint64_t> & Wakeups() const
+    {
+      return _wakeups;
+    }
+};
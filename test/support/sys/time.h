@@ -0,0 +1,20 @@
+//+--------------------------------------------------------------------------
+//
+// File:        sys/time.h
+//
+// Description:
+//
+//      Wraps the system header so that gettimeofday, which the bouncing
+//      balls and UnixTime use, reads the simulated clock from Arduino.h.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#pragma once
+
+#include_next <sys/time.h>
+
+inline int SimGetTimeOfDay(struct timeval * tv, void *);
+
+#define gettimeofday SimGetTimeOfDay
@@ -0,0 +1,237 @@
+//+--------------------------------------------------------------------------
+//
+// File:        test_main.cpp
+//
+// Description:
+//
+//      Runs test tones through a WAV file and SoundAnalyzer::AddSamples:
+//      tones have to land in the right band, a pulsing bass has to beat,
+//      and one analysis (window, FFT and banding) is timed.
+//
+//      Set AUDIO_WAV to the path of a 16-bit PCM recording to also print
+//      what the analyzer makes of it.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+#include <unity.h>
+#include <math.h>
+
+#include "benchmark.h"
+#include "audio.h"
+#include "wavfile.h"
+
+#define CHUNK_SAMPLES   (AUDIO_FFT_SIZE / 2)        //  One analysis per chunk, see SoundAnalyzer::Update
+
+// Tone
+//
+// 'seconds' of a sine at 'hz', its amplitude switching between 'loud' for the first 'pulseMs' of
+// every 500 ms and 'quiet' for the rest
+
+static size_t MakeTone(int16_t * samples, size_t count, float hz, int loud, int quiet = -1, int pulseMs = 500)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    int amplitude = (i * 1000 / AUDIO_SAMPLE_RATE) % 500 < (size_t) pulseMs ? loud : (quiet < 0 ? loud : quiet);
+    samples[i] = (int16_t)(amplitude * sinf(2.0f * (float) M_PI * hz * i / AUDIO_SAMPLE_RATE));
+  }
+  return count;
+}
+
+// Feeds a WAV file through the analyzer a chunk at a time, moving the clock along with the audio.
+// Returns the number of beats; 'loudestBand' gets the band that peaked most often.
+
+static int AnalyzeWav(WavReader & wav, SoundAnalyzer & analyzer, int * loudestBand = nullptr)
+{
+  int16_t chunk[CHUNK_SAMPLES];
+  int     wins[AUDIO_BANDS] = { 0 };
+  int     beats = 0;
+  size_t  count;
+
+  while ((count = wav.Read(chunk, CHUNK_SAMPLES)) > 0)
+  {
+    analyzer.AddSamples(chunk, count);
+    SimAdvanceMicros((uint64_t) count * 1000000 / wav.SampleRate());
+    analyzer.Update();
+
+    const AudioFeatures & features = analyzer.Features();
+    beats += features.Beat;
+
+    int loudest = 0;
+    for (int b = 1; b < AUDIO_BANDS; b++)
+      if (features.Bands[b] > features.Bands[loudest])
+        loudest = b;
+    if (features.Bands[loudest])
+      wins[loudest]++;
+  }
+
+  if (loudestBand)
+  {
+    *loudestBand = 0;
+    for (int b = 1; b < AUDIO_BANDS; b++)
+      if (wins[b] > wins[*loudestBand])
+        *loudestBand = b;
+  }
+  return beats;
+}
+
+static FILE * MakeWav(const int16_t * samples, size_t count)
+{
+  FILE * file = tmpfile();
+  TEST_ASSERT_NOT_NULL(file);
+  TEST_ASSERT_TRUE(WriteWav(file, samples, count, AUDIO_SAMPLE_RATE));
+  rewind(file);
+  return file;
+}
+
+static int BandOfBin(int bin)
+{
+  int band = 0;
+  while (AudioBandEdges[band] <= bin)
+    band++;
+  return band;
+}
+
+static int16_t tone[AUDIO_SAMPLE_RATE * 2];
+
+void setUp() {}
+void tearDown() {}
+
+void test_wav_round_trip()
+{
+  size_t count = MakeTone(tone, 1000, 440.0f, 12000);
+  FILE * file  = MakeWav(tone, count);
+
+  WavReader wav;
+  TEST_ASSERT_TRUE(wav.Open(file));
+  TEST_ASSERT_EQUAL_UINT32(AUDIO_SAMPLE_RATE, wav.SampleRate());
+
+  int16_t back[1200];
+  TEST_ASSERT_EQUAL_UINT32(count, wav.Read(back, 1200));
+  TEST_ASSERT_EQUAL_MEMORY(tone, back, count * sizeof(int16_t));
+  TEST_ASSERT_EQUAL_UINT32(0, wav.Read(back, 1200));
+
+  wav.Close();
+  fclose(file);
+}
+
+void test_wav_rejects_garbage()
+{
+  FILE * file = tmpfile();
+  fputs("RIFF....WAVEjunk", file);
+  rewind(file);
+
+  WavReader wav;
+  TEST_ASSERT_FALSE(wav.Open(file));
+  fclose(file);
+}
+
+void test_tones_land_in_their_band()
+{
+  // Bin centres, 80 Hz apart, from the bass up into the top band
+
+  static const int Bins[] = { 1, 2, 4, 8, 13, 20, 35, 60, 100 };
+  char message[64];
+
+  for (int bin : Bins)
+  {
+    size_t count = MakeTone(tone, AUDIO_SAMPLE_RATE / 2, bin * (float) AUDIO_SAMPLE_RATE / AUDIO_FFT_SIZE, 8000);
+    FILE * file  = MakeWav(tone, count);
+
+    WavReader     wav;
+    SoundAnalyzer analyzer;
+    int           band;
+
+    TEST_ASSERT_TRUE(wav.Open(file));
+    AnalyzeWav(wav, analyzer, &band);
+    fclose(file);
+
+    snprintf(message, sizeof(message), "bin %d went to band %d", bin, band);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(BandOfBin(bin), band, message);
+  }
+}
+
+void test_bass_pulses_beat()
+{
+  // Four seconds of 160 Hz, loud for 100 ms out of every 500: one beat per pulse, give or take the first
+
+  static int16_t pulses[AUDIO_SAMPLE_RATE * 4];
+  size_t count = MakeTone(pulses, sizeof(pulses) / sizeof(pulses[0]), 160.0f, 12000, 800, 100);
+  FILE * file  = MakeWav(pulses, count);
+
+  WavReader     wav;
+  SoundAnalyzer analyzer;
+
+  TEST_ASSERT_TRUE(wav.Open(file));
+  int beats = AnalyzeWav(wav, analyzer);
+  fclose(file);
+
+  TEST_ASSERT_INT_WITHIN(1, 8, beats);
+}
+
+void test_steady_tone_never_beats()
+{
+  size_t count = MakeTone(tone, sizeof(tone) / sizeof(tone[0]), 160.0f, 8000);
+  FILE * file  = MakeWav(tone, count);
+
+  WavReader     wav;
+  SoundAnalyzer analyzer;
+
+  TEST_ASSERT_TRUE(wav.Open(file));
+  AnalyzeWav(wav, analyzer);                                    //  let the running average settle
+  rewind(file);
+  TEST_ASSERT_TRUE(wav.Open(file));
+  TEST_ASSERT_EQUAL_INT(0, AnalyzeWav(wav, analyzer));
+  fclose(file);
+}
+
+void test_analysis_speed()
+{
+  SoundAnalyzer analyzer;
+  MakeTone(tone, CHUNK_SAMPLES, 1000.0f, 8000);
+
+  uint64_t ns = NanosPerCall([&]{ analyzer.AddSamples(tone, CHUNK_SAMPLES); analyzer.Update(); }, 2000);
+
+  char message[96];
+  snprintf(message, sizeof(message), "Analysis of %d samples: %llu ns, once every %d us of audio", AUDIO_FFT_SIZE,
+           (unsigned long long) ns, (int)(CHUNK_SAMPLES * 1000000ULL / AUDIO_SAMPLE_RATE));
+  TEST_MESSAGE(message);
+}
+
+void test_recording()
+{
+  const char * path = getenv("AUDIO_WAV");
+  if (!path)
+    return;
+
+  WavReader     wav;
+  SoundAnalyzer analyzer;
+  int           band;
+
+  TEST_ASSERT_TRUE_MESSAGE(wav.Open(path), path);
+  if (wav.SampleRate() != AUDIO_SAMPLE_RATE)
+    TEST_MESSAGE("recording is not at AUDIO_SAMPLE_RATE, so the bands are shifted");
+
+  int beats = AnalyzeWav(wav, analyzer, &band);
+
+  char message[96];
+  snprintf(message, sizeof(message), "%s: %d beats, band %d loudest most often", path, beats, band);
+  TEST_MESSAGE(message);
+}
+
+int main(int argc, char ** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_wav_round_trip);
+  RUN_TEST(test_wav_rejects_garbage);
+  RUN_TEST(test_tones_land_in_their_band);
+  RUN_TEST(test_bass_pulses_beat);
+  RUN_TEST(test_steady_tone_never_beats);
+  RUN_TEST(test_analysis_speed);
+  RUN_TEST(test_recording);
+  return UNITY_END();
+}
@@ -0,0 +1,163 @@
+//+--------------------------------------------------------------------------
+//
+// File:        test_main.cpp
+//
+// Description:
+//
+//      Timelines in text form as they come over Bluetooth, the values
+//      Evaluate() writes along them, what happens when the keys run out,
+//      and the cost of a frame with 64 parameters animated at once.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#include <Arduino.h>
+#include <unity.h>
+#include <string>
+
+#include "benchmark.h"
+#include "automation.h"
+
+#define BENCH_PARAMS        64
+#define BENCH_BUDGET_NS     5000            //  "a few microseconds" for the whole frame
+
+static ParameterAutomation automation;
+static float               values[BENCH_PARAMS];
+static ParamBinding        bindings[BENCH_PARAMS];
+static char                names[BENCH_PARAMS][8];
+static const char *        Groups[] = { "g0", "g1", "g2", "g3", "g4", "g5", "g6", "g7" };
+
+void setUp()
+{
+  // 64 float parameters, eight to a group, all at zero and none animated
+
+  automation = ParameterAutomation();
+  for (int i = 0; i < BENCH_PARAMS; i++)
+  {
+    values[i] = 0.0f;
+    snprintf(names[i], sizeof(names[i]), "p%d", i % 8);
+    bindings[i] = { names[i], ParamFloat, &values[i] };
+  }
+  for (int group = 0; group < BENCH_PARAMS / 8; group++)
+    automation.Register(Groups[group], &bindings[group * 8], 8);
+}
+
+void tearDown() {}
+
+void test_linear_timeline()
+{
+  TEST_ASSERT_TRUE(automation.Load("g0.p1 0=0 1000=2 2000=0", 0));
+
+  const struct { uint32_t ms; float value; } Expected[] =
+  {
+    { 0, 0.0f }, { 250, 0.5f }, { 1000, 2.0f }, { 1500, 1.0f }, { 2500, 1.0f }          //  loops every 2 s
+  };
+
+  for (const auto & expected : Expected)
+  {
+    automation.Evaluate(expected.ms);
+    TEST_ASSERT_INT_WITHIN(2, (int)(expected.value * 1000), (int)(values[1] * 1000));
+  }
+  TEST_ASSERT_EQUAL_INT(0, (int)(values[0] * 1000));
+}
+
+void test_key_limit()
+{
+  // Exactly AUTOMATION_LINE_KEYS keys is fine; one more is refused rather than cut short
+
+  std::string line = "g0.p0";
+  for (int i = 0; i < AUTOMATION_LINE_KEYS; i++)
+    line += " " + std::to_string(i * 100) + "=" + std::to_string(i);
+
+  TEST_ASSERT_TRUE(automation.Load(line.c_str(), 0));
+  TEST_ASSERT_EQUAL_UINT32(1, automation.TrackCount());
+
+  line += " 9999=1";
+  TEST_ASSERT_FALSE(automation.Load(line.c_str(), 0));
+
+  // The timeline that was there is untouched
+
+  TEST_ASSERT_EQUAL_UINT32(1, automation.TrackCount());
+  automation.Evaluate((AUTOMATION_LINE_KEYS - 1) * 100 - 50);
+  TEST_ASSERT_INT_WITHIN(2, (AUTOMATION_LINE_KEYS - 1) * 1000 - 500, (int)(values[0] * 1000));
+}
+
+// A timeline for a parameter with 'count' keys, 100 ms apart, going 0, 1, 2...
+
+static std::string Timeline(const char * name, int count)
+{
+  std::string line = name;
+  for (int i = 0; i < count; i++)
+    line += " " + std::to_string(i * 100) + "=" + std::to_string(i);
+  return line;
+}
+
+void test_full_pool_keeps_old_timeline()
+{
+  // Fill the key pool exactly: g0.p0 with 2 keys, 15 parameters with 16 and one with 14
+
+  TEST_ASSERT_TRUE(automation.Load(Timeline("g0.p0", 2).c_str(), 0));
+  for (int i = 1; i <= 15; i++)
+  {
+    std::string name = std::string(Groups[i / 8]) + ".p" + std::to_string(i % 8);
+    TEST_ASSERT_TRUE(automation.Load(Timeline(name.c_str(), 16).c_str(), 0));
+  }
+  TEST_ASSERT_TRUE(automation.Load(Timeline("g2.p0", 14).c_str(), 0));
+  TEST_ASSERT_EQUAL_UINT32(17, automation.TrackCount());
+
+  // Three keys in place of two is one too many, so g0.p0 carries on as it was; the same number of
+  // keys fits in the room its old timeline gives back
+
+  TEST_ASSERT_FALSE(automation.Load(Timeline("g0.p0", 3).c_str(), 0));
+  TEST_ASSERT_EQUAL_UINT32(17, automation.TrackCount());
+  automation.Evaluate(50);
+  TEST_ASSERT_INT_WITHIN(2, 500, (int)(values[0] * 1000));
+
+  TEST_ASSERT_TRUE(automation.Load("g0.p0 0=4 100=6", 0));
+  automation.Evaluate(50);
+  TEST_ASSERT_INT_WITHIN(2, 5000, (int)(values[0] * 1000));
+}
+
+void test_bad_lines()
+{
+  static const char * Lines[] = { "", "g9.p0 0=1", "g0.p0 0=1 x", "g0.p0 500=1 100=2", "g0.p0 100",
+                                  "g0.p0 0=32768", "g0.p0 0=-40000", "g0.p0 0=nan", "g0.p0 0=inf", "g0.p0 0=1e10" };
+
+  for (const char * line : Lines)
+    TEST_ASSERT_FALSE_MESSAGE(automation.Load(line, 0), line);
+  TEST_ASSERT_EQUAL_UINT32(0, automation.TrackCount());
+}
+
+void test_evaluate_64_params()
+{
+  // Every parameter animated, four keys each with a mix of curves, which fills the key pool
+
+  char line[64];
+  for (int i = 0; i < BENCH_PARAMS; i++)
+  {
+    snprintf(line, sizeof(line), "g%d.p%d 0=0 %d=1/%d %d=-1/%d 2000=0", i / 8, i % 8, 300 + i * 7, i % EaseCount, 1200 + i * 5, (i + 3) % EaseCount);
+    TEST_ASSERT_TRUE_MESSAGE(automation.Load(line, 0), line);
+  }
+  TEST_ASSERT_EQUAL_UINT32(BENCH_PARAMS, automation.TrackCount());
+
+  uint32_t msNow = 0;
+  uint64_t ns = NanosPerCall([&]{ automation.Evaluate(msNow += 16); }, 2000);
+
+  char message[96];
+  snprintf(message, sizeof(message), "Evaluate with %d animated parameters: %llu ns/frame", BENCH_PARAMS, (unsigned long long) ns);
+  TEST_MESSAGE(message);
+
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(BENCH_BUDGET_NS, ns);
+}
+
+int main(int argc, char ** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_linear_timeline);
+  RUN_TEST(test_key_limit);
+  RUN_TEST(test_full_pool_keeps_old_timeline);
+  RUN_TEST(test_bad_lines);
+  RUN_TEST(test_evaluate_64_params);
+  return UNITY_END();
+}
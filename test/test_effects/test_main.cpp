@@ -0,0 +1,113 @@
+//+--------------------------------------------------------------------------
+//
+// File:        test_main.cpp
+//
+// Description:
+//
+//      Every effect at 60 LEDs, the strip's real length: draws a fixed run
+//      of frames from a fixed seed and compares their CRC with the golden
+//      value, so any change to what an effect puts on the strip shows up
+//      here, then checks each effect's frame time against its budget.
+//
+//      When an effect is changed on purpose, run the suite and copy the new
+//      CRC from the failure into Goldens.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#define NUM_LEDS        60
+#define UK_LEDS         30
+#define MATRIX_WIDTH    6
+#define MATRIX_HEIGHT   10
+
+#include "effectsuite.h"
+
+#define GOLDEN_FRAMES   200
+
+struct GoldenFrames
+{
+  char      key;
+  uint32_t  crc;
+};
+
+static const GoldenFrames Goldens[] =
+{
+  { 'a', 0xBB1EE294 },
+  { 'b', 0x1284FAE1 },
+  { 'c', 0x7A9C104D },
+  { 'd', 0xD880CC2C },
+  { 'e', 0xBE3AF778 },
+  { 'f', 0x60C78297 },
+  { 'g', 0xA56EE06D },
+  { 'h', 0x2961F6E8 },
+  { 'i', 0xDCDF1A2D },
+  { 'j', 0x785DC10B },
+  { 'k', 0x24423EEF },
+  { 'l', 0x158CB4DA },
+  { 'm', 0x40FB8626 },
+  { 'n', 0x1536EF46 },
+  { 'o', 0xAEF65C8F },
+  { 'p', 0x5E3B4B02 },
+  { 'q', 0x82E93115 },
+  { 'r', 0xFD182E9C },
+  { 's', 0xA292484D },
+  { 't', 0x2070D62D },
+  { 'u', 0x4941801A },
+  { 'v', 0x8473AE13 },
+  { 'w', 0x87708083 },
+};
+
+void setUp() {}
+void tearDown() {}
+
+void test_golden_frames()
+{
+  char message[80];
+  bool bMismatch = false;
+
+  for (size_t i = 0; i < ARRAYSIZE(Effects); i++)
+  {
+    uint32_t expected = 0;
+    for (size_t g = 0; g < ARRAYSIZE(Goldens); g++)
+      if (Goldens[g].key == Effects[i].key)
+        expected = Goldens[g].crc;
+
+    uint32_t crc = DrawFrames(Effects[i], GOLDEN_FRAMES);
+    if (crc != expected)
+    {
+      snprintf(message, sizeof(message), "'%c' drew 0x%08X, golden is 0x%08X", Effects[i].key, crc, expected);
+      TEST_MESSAGE(message);
+      bMismatch = true;
+    }
+  }
+  TEST_ASSERT_FALSE_MESSAGE(bMismatch, "frames differ from the goldens");
+}
+
+void test_spectrum_fills_strip()
+{
+  // 60 LEDs don't split evenly into the bands; with every band loud, no pixel is left dark
+
+  AudioFeatures features = {};
+  memset(features.Bands, 255, sizeof(features.Bands));
+
+  DrawSpectrum(features);
+  for (int i = 0; i < NUM_LEDS; i++)
+    TEST_ASSERT_TRUE_MESSAGE(h_LEDs[i] != CRGB(CRGB::Black), "dark pixel in the spectrum");
+}
+
+void test_frame_budget()
+{
+  CheckFrameBudgets();
+}
+
+int main(int argc, char ** argv)
+{
+  SetupSuite();
+
+  UNITY_BEGIN();
+  RUN_TEST(test_golden_frames);
+  RUN_TEST(test_spectrum_fills_strip);
+  RUN_TEST(test_frame_budget);
+  return UNITY_END();
+}
@@ -0,0 +1,37 @@
+//+--------------------------------------------------------------------------
+//
+// File:        test_main.cpp
+//
+// Description:
+//
+//      Every effect at 1000 LEDs, checked against the same per-LED frame
+//      budget as the 60 LED suite, so an effect that scales worse than
+//      linearly with the strip length fails here first.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#define NUM_LEDS        1000
+#define UK_LEDS         500
+#define MATRIX_WIDTH    25
+#define MATRIX_HEIGHT   40
+
+#include "effectsuite.h"
+
+void setUp() {}
+void tearDown() {}
+
+void test_frame_budget()
+{
+  CheckFrameBudgets();
+}
+
+int main(int argc, char ** argv)
+{
+  SetupSuite();
+
+  UNITY_BEGIN();
+  RUN_TEST(test_frame_budget);
+  return UNITY_END();
+}
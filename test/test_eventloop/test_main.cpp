@@ -0,0 +1,211 @@
+//+--------------------------------------------------------------------------
+//
+// File:        test_main.cpp
+//
+// Description:
+//
+//      Drives the EventLoop the way main.cpp does, through effectslot.h
+//      and the real effect table, on a scripted event source where every
+//      callback costs simulated time: keys arrive at a steady rate, each one
+//      starts an effect, and every frame arms the one-shot stats and power
+//      timers.  A static effect must leave the loop asleep from those
+//      timers until the next key; an animated one must get exactly its
+//      frames, and the loop's wakeups and utilization must add up.
+//
+// History:     Oct-19-2026     tomwer      Created
+//                              tomwer      Real slot scheduling, callbacks with a cost
+//
+//---------------------------------------------------------------------------
+
+#define NUM_LEDS        60
+#define UK_LEDS         30
+#define MATRIX_WIDTH    6
+#define MATRIX_HEIGHT   10
+
+#include "effectsuite.h"
+#include "simeventsource.h"
+#include "effectslot.h"
+
+#include <string>
+
+#define CALLBACK_US     2000                            //  What a frame, the stats or the power estimate costs on the device
+
+SimulatedEventSource source;
+EventLoop            events(source);
+
+EffectSlot currentSlot;
+WheelTimer statsTimer;
+WheelTimer powerTimer;
+
+int frames = 0;
+
+// DrawSlot in main.cpp with no transition running: draw, then re-arm the stats and power timers
+
+void DrawSlot(void * pContext)
+{
+  EffectSlot & slot = *(EffectSlot *) pContext;
+
+  slot.pEffect->draw();
+  source.Work();
+  frames++;
+  FrameDrawn(events, statsTimer, powerTimer);
+}
+
+void OtherTimer(void *)
+{
+  source.Work();
+}
+
+// Runs the loop until the '.' key, starting the effect each key selects the way HandleKey does
+
+void RunLoop()
+{
+  LoopEvent event;
+
+  for (;;)
+  {
+    events.Wait(event);
+    if (event.key == '.')
+      return;
+
+    const LedEffect * pSelected = FindLedEffect(event.key);
+    if (!pSelected || pSelected == currentSlot.pEffect)
+      continue;
+
+    events.Cancel(currentSlot.timer);
+    StartSlot(events, currentSlot, pSelected, 0);
+  }
+}
+
+// A fresh loop whose callbacks each take usPerCallback of simulated time
+
+void StartLoop(uint64_t usPerCallback)
+{
+  currentSlot.pEffect = nullptr;
+  currentSlot.timer   = WheelTimer(DrawSlot, &currentSlot);
+  statsTimer = WheelTimer(OtherTimer);
+  powerTimer = WheelTimer(OtherTimer);
+  frames = 0;
+
+  source = SimulatedEventSource(usPerCallback);
+  events.Begin();
+}
+
+void setUp()
+{
+  StartLoop(0);
+}
+
+void tearDown()
+{
+  events.Cancel(currentSlot.timer);
+  events.Cancel(statsTimer);
+  events.Cancel(powerTimer);
+}
+
+void test_static_effect_sleeps_between_keys()
+{
+  static const int KeysPerMinute[] = { 1, 6, 30 };
+  char message[96];
+  std::string staticKeys;
+
+  for (const LedEffect & effect : Effects)
+    if (effect.msPerFrame == STATIC_EFFECT)
+      staticKeys += effect.key;
+
+  for (int rate : KeysPerMinute)
+  {
+    StartLoop(CALLBACK_US);
+
+    const uint64_t msBetweenKeys = 60000 / rate;
+    const int      keys          = rate * 10;               //  ten minutes' worth
+    const uint64_t usFirst       = SimClockMicros() + msBetweenKeys * 1000;
+
+    for (int i = 1; i <= keys; i++)
+      source.Script(i * msBetweenKeys, { InputEvent, staticKeys[i % staticKeys.size()] });
+    source.Script((keys + 1) * msBetweenKeys, { InputEvent, '.' });
+
+    RunLoop();
+    TEST_ASSERT_EQUAL_INT(keys, frames);
+
+    // Once the power timer the frame armed has gone off nothing is left, so nothing may wake the
+    // loop until the next key.  The frame took CALLBACK_US before it armed the timer, and before
+    // that the wheel may also wake once to cascade the power timer down a level.
+
+    int strays = 0;
+    for (uint64_t usWakeup : source.Wakeups())
+    {
+      uint64_t msAfterKey = (usWakeup - usFirst) / 1000 % msBetweenKeys;
+      if (usWakeup >= usFirst && msAfterKey > POWER_MS + CALLBACK_US / 1000)
+        strays++;
+    }
+
+    snprintf(message, sizeof(message), "%d keys/minute: %u wakeups in 10 minutes, %d while idle", rate,
+             (unsigned) source.Wakeups().size(), strays);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_EQUAL_INT(0, strays);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(keys * 4 + 1, source.Wakeups().size());
+    TEST_ASSERT_EQUAL_INT(0, events.Utilization());                  //  a frame, stats and power in seconds of sleep
+    tearDown();
+  }
+}
+
+void test_animated_effect_gets_every_frame()
+{
+  static const char Keys[] = { 'a', 'l' };                  //  comet every 20 ms, fire every 10
+  char message[96];
+
+  for (char key : Keys)
+  {
+    StartLoop(CALLBACK_US);
+    const LedEffect & effect = *FindLedEffect(key);
+
+    source.Script(0, { InputEvent, key });
+    source.Script(60000, { InputEvent, '.' });
+
+    RunLoop();
+
+    // Frames at 0, 20, ... 60000 ms, and the '.' arrives in the same millisecond as the last one.
+    // Each frame, stats refresh and power estimate is a wakeup of its own and costs CALLBACK_US.
+
+    unsigned int wakeups     = 1000 / effect.msPerFrame + 1000 / STATS_MS + 1000 / POWER_MS;
+    unsigned int utilization = wakeups * CALLBACK_US / 10000;
+
+    snprintf(message, sizeof(message), "'%c' every %lu ms: %u wakeups/s, %u%% busy", key, effect.msPerFrame,
+             events.WakeupsPerSecond(), events.Utilization());
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_INT_WITHIN(1, 60000 / effect.msPerFrame, frames);
+    TEST_ASSERT_INT_WITHIN(1, wakeups, events.WakeupsPerSecond());
+    TEST_ASSERT_INT_WITHIN(1, utilization, events.Utilization());
+    tearDown();
+  }
+}
+
+void test_nothing_to_do_sleeps_forever()
+{
+  LoopEvent event;
+  source.Script(0, { InputEvent, '?' });
+  events.Wait(event);
+
+  size_t before = source.Wakeups().size();
+  uint64_t usBefore = SimClockMicros();
+
+  // With no timers armed the only way out of Wait is an event, so script one far away
+
+  source.Script(3600000, { InputEvent, '.' });
+  events.Wait(event);
+
+  TEST_ASSERT_EQUAL_INT(before + 1, source.Wakeups().size());
+  TEST_ASSERT_EQUAL_UINT32(3600000, (SimClockMicros() - usBefore) / 1000);
+}
+
+int main(int argc, char ** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_static_effect_sleeps_between_keys);
+  RUN_TEST(test_animated_effect_gets_every_frame);
+  RUN_TEST(test_nothing_to_do_sleeps_forever);
+  return UNITY_END();
+}
@@ -0,0 +1,251 @@
+//+--------------------------------------------------------------------------
+//
+// File:        test_main.cpp
+//
+// Description:
+//
+//      Checks the packed diffusion in fire2d.h against the same stencil
+//      worked out one cell at a time and a column of the panel against the
+//      strip fire in fire.h, keeps sparks inside short panels, and times a
+//      frame on square panels from 8x8 up to 128x128.
+//
+// History:     Oct-19-2026     tomwer      Created
+//                              tomwer      Column against FireEffect, sparks checked for bounds
+//
+//---------------------------------------------------------------------------
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+#include <unity.h>
+#include <vector>
+
+#include "benchmark.h"
+
+#define MAX_SIDE    128
+#define NUM_LEDS    (MAX_SIDE * MAX_SIDE)          //  for ledgfx.h, which fire.h draws through
+
+CRGB h_LEDs[NUM_LEDS];
+
+#include "fire.h"
+#include "fire2d.h"
+
+#define FIRE2D_TARGET_SIDE          32          //  the panel size the effect is meant to run at 60 FPS on the ESP32
+#define FIRE2D_BUDGET_NS_PER_CELL   2000        //  the same 2 us per LED as the effect suite's frame budget
+
+// Opens up the heat grid so the test can set it and read it back
+
+class Fire2DProbe : public Fire2DEffect
+{
+  public:
+
+    Fire2DProbe(int width, int height, int sparkHeight = 2)
+      : Fire2DEffect(width, height, 20, 255, 8, sparkHeight)
+    {
+    }
+
+    byte & Heat(int x, int y)
+    {
+      return Row(y)[x];
+    }
+
+    void Diffuse(int y)
+    {
+      DiffuseRow(y);
+    }
+
+    // What DrawFire does to the heat between cooling and sparking
+
+    void DiffuseAll()
+    {
+      for (int y = 0; y < Height; y++)
+        DiffuseRow(y);
+    }
+
+    int MaxSparkHeight() const
+    {
+      return SparkHeight;
+    }
+
+    // True if nothing has been written outside the grid: the zero bytes either side of every row,
+    // the spare row's included, and the row standing in for below the bottom edge
+
+    bool EdgesClear() const
+    {
+      for (int y = 0; y < Height; y++)
+        if (rows[y][-1] || rows[y][Width])
+          return false;
+
+      if (spare[-1] || spare[Width])
+        return false;
+
+      for (int x = -1; x <= Width; x++)
+        if (zeroRow[x])
+          return false;
+
+      return true;
+    }
+};
+
+// The strip fire with its heat opened up, neither reversed nor mirrored so heat[0] is the top
+
+class FireProbe : public FireEffect
+{
+  public:
+
+    FireProbe(int size)
+      : FireEffect(size, 20, 255, 8, 4, false, false)
+    {
+    }
+
+    byte & Heat(int i)
+    {
+      return heat[i];
+    }
+
+    void Drift()
+    {
+      DriftHeat();
+    }
+};
+
+void setUp()
+{
+  random16_set_seed(0x0320);
+}
+
+void tearDown() {}
+
+// FireEffect's stencil on the panel: each cell from itself, the three cells below it and the two under those
+
+static byte DiffuseCell(const std::vector<byte> & heat, int width, int height, int x, int y)
+{
+  auto at = [&](int cx, int cy) -> int
+  {
+    return cx < 0 || cx >= width || cy >= height ? 0 : heat[cy * width + cx];
+  };
+
+  return (at(x, y) * 2 + (at(x - 1, y + 1) + at(x, y + 1) + at(x + 1, y + 1)) + at(x, y + 2) * 2 + at(x, y + 3)) / 8;
+}
+
+void test_diffusion_matches_cells()
+{
+  // Widths around the four-cell word leave every length of scalar tail, and full heat checks the lanes don't spill
+
+  static const int Widths[] = { 1, 3, 4, 5, 7, 8, 9, 33 };
+  const int height = 6;
+
+  for (int width : Widths)
+  {
+    for (int fill = 0; fill < 2; fill++)
+    {
+      Fire2DProbe fire(width, height);
+      std::vector<byte> heat(width * height);
+
+      for (int y = 0; y < height; y++)
+        for (int x = 0; x < width; x++)
+          heat[y * width + x] = fire.Heat(x, y) = fill ? 255 : random8();
+
+      // Top down, like DrawFire, so each row is worked from the undiffused rows below it
+
+      std::vector<byte> expected(width * height);
+      for (int y = 0; y < height; y++)
+      {
+        for (int x = 0; x < width; x++)
+          expected[y * width + x] = DiffuseCell(heat, width, height, x, y);
+        fire.Diffuse(y);
+      }
+
+      for (int y = 0; y < height; y++)
+        for (int x = 0; x < width; x++)
+          TEST_ASSERT_EQUAL_UINT8(expected[y * width + x], fire.Heat(x, y));
+    }
+  }
+}
+
+void test_column_burns_like_the_strip()
+{
+  // Every row one heat all the way across, so a column has nothing to gain or lose from its
+  // neighbors, and the middle one is far enough from the sides that what leaks out there can't
+  // reach it in the frames run.  It has to drift and diffuse exactly as the strip does.  The top
+  // of the strip stays cold, so FireEffect wrapping its bottom cells round to the top adds nothing.
+
+  const int frames = 8;
+  const int width  = frames * 2 + 1;
+  const int height = 40;
+
+  Fire2DProbe panel(width, height);
+  FireProbe   strip(height);
+
+  for (int y = 0; y < height; y++)
+  {
+    byte heat = y >= height - 12 ? random8() : 0;
+    strip.Heat(y) = heat;
+    for (int x = 0; x < width; x++)
+      panel.Heat(x, y) = heat;
+  }
+
+  for (int frame = 0; frame < frames; frame++)
+  {
+    panel.DiffuseAll();
+    strip.Drift();
+
+    for (int y = 0; y < height; y++)
+      TEST_ASSERT_EQUAL_UINT8(strip.Heat(y), panel.Heat(frames, y));
+  }
+  TEST_ASSERT_EQUAL_UINT8(0, strip.Heat(2));                //  still cold at the top, so the strip never wrapped
+}
+
+void test_sparks_stay_on_the_panel()
+{
+  // A spark height taller than the panel is cut down to the panel, so sparks never land above row 0,
+  // nor anywhere else outside the grid or past the panel's LEDs
+
+  const CRGB marker = CRGB(1, 2, 3);
+  fill_solid(h_LEDs, 20, marker);
+
+  Fire2DProbe fire(5, 2, 10);
+  TEST_ASSERT_EQUAL_INT(2, fire.MaxSparkHeight());
+
+  for (int frame = 0; frame < 500; frame++)
+  {
+    fire.DrawFire(h_LEDs);
+    TEST_ASSERT_TRUE(fire.EdgesClear());
+  }
+
+  for (int i = 10; i < 20; i++)
+    TEST_ASSERT_TRUE(h_LEDs[i] == marker);
+
+  bool bLit = false;
+  for (int i = 0; i < 10; i++)
+    bLit |= (bool) h_LEDs[i];
+  TEST_ASSERT_TRUE(bLit);
+}
+
+void test_frame_speed()
+{
+  char message[96];
+
+  for (int side = 8; side <= MAX_SIDE; side *= 2)
+  {
+    Fire2DEffect fire(side, side, 60, 120, 3, 2, true);
+    uint64_t ns = NanosPerCall([&]{ fire.DrawFire(h_LEDs); }, 4096 * 16 / (side * side) + 10);
+
+    snprintf(message, sizeof(message), "Fire %dx%d: %llu ns/frame, %llu ns/cell",
+             side, side, (unsigned long long) ns, (unsigned long long) ns / (side * side));
+    TEST_MESSAGE(message);
+
+    if (side == FIRE2D_TARGET_SIDE)
+      TEST_ASSERT_LESS_OR_EQUAL_UINT32(FIRE2D_BUDGET_NS_PER_CELL * side * side, ns);
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_diffusion_matches_cells);
+  RUN_TEST(test_column_burns_like_the_strip);
+  RUN_TEST(test_sparks_stay_on_the_panel);
+  RUN_TEST(test_frame_speed);
+  return UNITY_END();
+}
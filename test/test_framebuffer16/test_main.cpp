@@ -0,0 +1,200 @@
+//+--------------------------------------------------------------------------
+//
+// File:        test_main.cpp
+//
+// Description:
+//
+//      The 16-bit render path against the 8-bit one it replaces for the HP
+//      comet: what a long fade looks like on the strip at half brightness,
+//      what a frame costs each way, and the brightness handed to the blend
+//      when a transition pairs a self-scaling effect with an 8-bit one.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+#include <unity.h>
+#include <math.h>
+
+#include "benchmark.h"
+
+#define NUM_LEDS    5000
+
+CRGB h_LEDs[NUM_LEDS];
+
+#include "framebuffer16.h"
+#include "transition.h"
+
+#define BRIGHTNESS  128
+#define GAMMA       2.2f
+
+#define FRAME_BUDGET_NS_PER_LED     2000        //  main.cpp's FRAME_BUDGET_US, per LED
+#define QUANTIZE_BUDGET_NS_PER_LED  (FRAME_BUDGET_NS_PER_LED / 10)      //  the output pass gets a tenth of the frame
+
+void setUp() {}
+void tearDown() {}
+
+// What reaches the LED on the 8-bit path: the 8-bit pixel, scaled by FastLED's brightness on the way out
+
+static uint8_t Shown8(uint8_t value)
+{
+  return scale8(value, BRIGHTNESS);
+}
+
+void test_full_scale_round_trips()
+{
+  // No brightness and no gamma: every 8-bit value comes straight back out, with no dither left over
+
+  HighPrecisionBuffer buffer(256);
+  for (int i = 0; i < 256; i++)
+    buffer.SetPixel(i, CRGB(i, i, i));
+
+  for (int frame = 0; frame < 3; frame++)
+  {
+    buffer.Quantize(h_LEDs);
+    for (int i = 0; i < 256; i++)
+      TEST_ASSERT_EQUAL_UINT8(i, h_LEDs[i].r);
+  }
+}
+
+void test_dither_averages_to_exact_value()
+{
+  // At half brightness a pixel between two 8-bit steps alternates so that its average is right
+
+  HighPrecisionBuffer buffer(1);
+  buffer.SetPixel(0, CRGB(101, 0, 0));
+
+  uint32_t sum = 0;
+  for (int frame = 0; frame < 256; frame++)
+  {
+    buffer.Quantize(h_LEDs, BRIGHTNESS);
+    sum += h_LEDs[0].r;
+  }
+
+  // 101 * 129 / 256 = 50.9, so 256 frames add up to 101 * 129
+
+  TEST_ASSERT_INT_WITHIN(1, 101 * 129, sum);
+}
+
+void test_long_fade_tracks_the_ideal()
+{
+  // A slow fade from full at half brightness, with no gamma so both paths aim at the same light.
+  // Summed over the fade, the 16-bit path stays closer to the exact curve than the 8-bit one,
+  // which sticks on a step and then drops to black well before the fade is over.
+
+  const uint8_t fadeBy = 4;
+  HighPrecisionBuffer buffer(1);
+  buffer.SetPixel(0, CRGB(255, 0, 0));
+  uint8_t pixel8 = 255;
+
+  double ideal = 255.0 * (BRIGHTNESS + 1) / 256;
+  double error16 = 0, error8 = 0;
+
+  for (int frame = 0; frame < 400; frame++)
+  {
+    buffer.FadeToBlackBy(fadeBy);
+    buffer.Quantize(h_LEDs, BRIGHTNESS);
+    pixel8 = scale8(pixel8, 255 - fadeBy);
+    ideal  = ideal * (256 - fadeBy) / 256;
+
+    error16 += fabs(h_LEDs[0].r - ideal);
+    error8  += fabs(Shown8(pixel8) - ideal);
+  }
+
+  char message[96];
+  snprintf(message, sizeof(message), "Fade at brightness %d: total error %.1f in 16 bits, %.1f in 8", BRIGHTNESS, error16, error8);
+  TEST_MESSAGE(message);
+
+  TEST_ASSERT_EQUAL_UINT8(0, h_LEDs[0].r);
+  TEST_ASSERT_TRUE(error16 < error8);
+}
+
+void test_gamma_keeps_its_ends()
+{
+  // Gamma bends the middle of the range down but leaves black and full where they are
+
+  HighPrecisionBuffer buffer(3, GAMMA);
+  buffer.SetPixel(0, CRGB::Black);
+  buffer.SetPixel(1, CRGB(128, 128, 128));
+  buffer.SetPixel(2, CRGB::White);
+  buffer.Quantize(h_LEDs);
+
+  TEST_ASSERT_EQUAL_UINT8(0, h_LEDs[0].r);
+  TEST_ASSERT_INT_WITHIN(1, 56, h_LEDs[1].r);
+  TEST_ASSERT_EQUAL_UINT8(255, h_LEDs[2].r);
+}
+
+void test_mixed_transition_brightness()
+{
+  // An 8-bit effect fading out into a self-scaling one: at the very start of the blend the
+  // composite is the outgoing frame with the strip's brightness applied, since it goes out unscaled
+
+  TransitionEngine transition(NUM_LEDS);
+  for (int i = 0; i < NUM_LEDS; i++)
+    h_LEDs[i] = CRGB(i, 255 - (i & 0xFF), 200);
+
+  CRGB expected[3];
+  for (int i = 0; i < 3; i++)
+    expected[i] = CRGB(h_LEDs[i]).nscale8(BRIGHTNESS);
+
+  transition.Start(Crossfade, 1000);
+  transition.Compose(BRIGHTNESS, 255);
+
+  TEST_ASSERT_EQUAL_MEMORY(expected, h_LEDs, sizeof(expected));
+}
+
+void test_quantize_speed()
+{
+  static const size_t Sizes[] = { 60, 1000, 5000 };
+  char message[128];
+
+  for (size_t size : Sizes)
+  {
+    HighPrecisionBuffer buffer(size, GAMMA);
+    int iPos = 0;
+
+    // One comet frame each way: five pixels drawn, everything faded, and the brightness applied
+
+    uint64_t ns16 = NanosPerCall([&]{
+      iPos = (iPos + 1) % (size - 5);
+      for (int i = 0; i < 5; i++)
+        buffer.SetPixel(iPos + i, CRGB::Red);
+      buffer.FadeToBlackBy(64);
+      buffer.Quantize(h_LEDs, BRIGHTNESS);
+    }, 200);
+
+    uint64_t ns8 = NanosPerCall([&]{
+      iPos = (iPos + 1) % (size - 5);
+      for (int i = 0; i < 5; i++)
+        h_LEDs[iPos + i] = CRGB::Red;
+      fadeToBlackBy(h_LEDs, size, 64);
+      for (size_t i = 0; i < size; i++)
+        h_LEDs[i].nscale8(BRIGHTNESS);
+    }, 200);
+
+    uint64_t nsQuantize = NanosPerCall([&]{ buffer.Quantize(h_LEDs, BRIGHTNESS); }, 200);
+
+    snprintf(message, sizeof(message), "Comet frame %u LEDs: 16-bit with gamma and dither %llu ns (Quantize %llu ns), 8-bit %llu ns",
+             (unsigned) size, (unsigned long long) ns16, (unsigned long long) nsQuantize, (unsigned long long) ns8);
+    TEST_MESSAGE(message);
+
+    // Nothing else stops the output pass creeping up on the effects' own budget
+
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(QUANTIZE_BUDGET_NS_PER_LED * size, nsQuantize);
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_full_scale_round_trips);
+  RUN_TEST(test_dither_averages_to_exact_value);
+  RUN_TEST(test_long_fade_tracks_the_ideal);
+  RUN_TEST(test_gamma_keeps_its_ends);
+  RUN_TEST(test_mixed_transition_brightness);
+  RUN_TEST(test_quantize_speed);
+  return UNITY_END();
+}
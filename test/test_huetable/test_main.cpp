@@ -0,0 +1,100 @@
+//+--------------------------------------------------------------------------
+//
+// File:        test_main.cpp
+//
+// Description:
+//
+//      The hue tables against the conversions they stand in for, color for
+//      color and per pixel cost: RainbowHues against setHue on every LED,
+//      and a saturation 240 table against fill_rainbow.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+#include <unity.h>
+
+#include "benchmark.h"
+#include "huetable.h"
+
+#define MAX_LEDS    5000
+
+static CRGB converted[MAX_LEDS];
+static CRGB looked[MAX_LEDS];
+
+static const HueTable FillRainbowHues(240);             //  fill_rainbow's saturation
+
+static const int Lengths[] = { 60, 5000 };
+
+void setUp() {}
+void tearDown() {}
+
+// What the effects did before the table: a conversion per pixel
+
+static void SetHueEach(CRGB * leds, int count, uint8_t startHue, uint8_t deltaHue)
+{
+  uint8_t hue = startHue;
+  for (int i = 0; i < count; i++, hue += deltaHue)
+    leds[i].setHue(hue);
+}
+
+void test_table_matches_sethue()
+{
+  for (int hue = 0; hue < 256; hue++)
+  {
+    CRGB expected;
+    expected.setHue(hue);
+    TEST_ASSERT_EQUAL_MEMORY(&expected, &RainbowHues[hue], sizeof(CRGB));
+  }
+
+  SetHueEach(converted, 300, 17, 3);
+  fill_hue_gradient(looked, 300, 17, 3);
+  TEST_ASSERT_EQUAL_MEMORY(converted, looked, 300 * sizeof(CRGB));
+}
+
+void test_table_matches_fill_rainbow()
+{
+  static const uint8_t Deltas[] = { 1, 5, 8, 255 };
+
+  for (uint8_t delta : Deltas)
+  {
+    fill_rainbow(converted, 300, HUE_BLUE, delta);
+    fill_hue_gradient(looked, 300, HUE_BLUE, delta, FillRainbowHues);
+    TEST_ASSERT_EQUAL_MEMORY(converted, looked, 300 * sizeof(CRGB));
+  }
+}
+
+void test_fill_speed()
+{
+  char message[128];
+
+  for (int length : Lengths)
+  {
+    uint8_t start = 0;
+    const int reps = 200000 / length;
+
+    uint64_t nsSetHue   = NanosPerCall([&]{ SetHueEach(converted, length, start += 4, 8); }, reps);
+    uint64_t nsRainbow  = NanosPerCall([&]{ fill_rainbow(converted, length, start += 4, 8); }, reps);
+    uint64_t nsTable255 = NanosPerCall([&]{ fill_hue_gradient(looked, length, start += 4, 8); }, reps);
+    uint64_t nsTable240 = NanosPerCall([&]{ fill_hue_gradient(looked, length, start += 4, 8, FillRainbowHues); }, reps);
+
+    snprintf(message, sizeof(message), "%d LEDs, ns/pixel: setHue %.1f vs table %.1f at sat 255; fill_rainbow %.1f vs table %.1f at sat 240",
+             length, (double) nsSetHue / length, (double) nsTable255 / length, (double) nsRainbow / length, (double) nsTable240 / length);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_LESS_THAN_UINT32(nsSetHue, nsTable255);
+    TEST_ASSERT_LESS_THAN_UINT32(nsRainbow, nsTable240);
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_table_matches_sethue);
+  RUN_TEST(test_table_matches_fill_rainbow);
+  RUN_TEST(test_fill_speed);
+  return UNITY_END();
+}
@@ -0,0 +1,166 @@
+//+--------------------------------------------------------------------------
+//
+// File:        test_main.cpp
+//
+// Description:
+//
+//      Checks the layout's sorted orders and the plane sweep that walks
+//      them against a sweep that measures every pixel, on strips, rings and
+//      matrices, and times Load and both sweeps at 16, 256 and 4096 LEDs.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+#include <unity.h>
+
+#include "benchmark.h"
+
+#define NUM_LEDS    4096
+
+CRGB h_LEDs[NUM_LEDS];
+
+#include "layout.h"
+#include "spatialfx.h"
+
+static LedCoord coords[NUM_LEDS];
+static CRGB     expected[NUM_LEDS];
+
+// The sweep as it was before it used the sorted order: every pixel's distance from the plane
+
+void SweepEveryPixel(const LedLayout & layout, LayoutAxis axis, CRGB color, uint8_t width = 32)
+{
+  const uint8_t * coords = layout.Coords(axis);
+  const uint16_t  falloff = 256 / max((uint8_t) 1, width);
+  uint8_t plane = beatsin8(20);
+
+  for (size_t i = 0; i < layout.Count(); i++)
+  {
+    uint16_t fade = abs(coords[i] - plane) * falloff;
+    h_LEDs[i] = fade < 255 ? CRGB(color).nscale8_video(255 - fade) : CRGB(CRGB::Black);
+  }
+}
+
+// Runs both sweeps over a whole swing of the plane and fails on the first frame that differs
+
+void CheckSweep(const LedLayout & layout, uint8_t width)
+{
+  for (int frame = 0; frame < 200; frame++)
+  {
+    for (int axis = 0; axis < AxisCount; axis++)
+    {
+      SweepEveryPixel(layout, (LayoutAxis) axis, CRGB::Blue, width);
+      memcpy(expected, h_LEDs, layout.Count() * sizeof(CRGB));
+      DrawPlaneSweep(layout, (LayoutAxis) axis, CRGB::Blue, width);
+      TEST_ASSERT_EQUAL_MEMORY(expected, h_LEDs, layout.Count() * sizeof(CRGB));
+    }
+    SimAdvanceMillis(17);
+  }
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_orders_are_sorted()
+{
+  MakeRingCoords(coords, 256, 20);
+  LedLayout layout(256);
+  layout.Load(coords);
+
+  for (int axis = 0; axis < AxisCount; axis++)
+  {
+    const uint8_t * c = layout.Coords((LayoutAxis) axis);
+    for (size_t iPos = 1; iPos < layout.Count(); iPos++)
+      TEST_ASSERT_TRUE(c[layout.PixelAt((LayoutAxis) axis, iPos - 1)] <= c[layout.PixelAt((LayoutAxis) axis, iPos)]);
+
+    for (int value = 0; value < 256; value++)
+    {
+      size_t iPos = layout.FirstAtOrAbove((LayoutAxis) axis, value);
+      TEST_ASSERT_TRUE(iPos == layout.Count() || c[layout.PixelAt((LayoutAxis) axis, iPos)] >= value);
+      TEST_ASSERT_TRUE(iPos == 0 || c[layout.PixelAt((LayoutAxis) axis, iPos - 1)] < value);
+    }
+  }
+}
+
+void test_sweep_strip()
+{
+  MakeStripCoords(coords, 60);
+  LedLayout layout(60);
+  layout.Load(coords);
+
+  CheckSweep(layout, 32);
+  CheckSweep(layout, 1);
+  CheckSweep(layout, 255);
+}
+
+void test_sweep_ring()
+{
+  MakeRingCoords(coords, 16, 16);
+  LedLayout layout(16);
+  layout.Load(coords);
+
+  CheckSweep(layout, 32);
+  CheckSweep(layout, 8);
+}
+
+void test_sweep_matrix()
+{
+  MakeMatrixCoords(coords, 64, 64, true);
+  LedLayout layout(4096);
+  layout.Load(coords);
+
+  CheckSweep(layout, 32);
+  CheckSweep(layout, 100);
+}
+
+void test_layout_pixels_follow_axis()
+{
+  // Three whole pixels from the top of a serpentine panel light its top row, whatever the wiring
+
+  MakeMatrixCoords(coords, 3, 3, true);
+  LedLayout layout(9);
+  layout.Load(coords);
+
+  FastLED.addLeds(h_LEDs, 9);
+  FastLED.clear();
+  DrawLayoutPixels(layout, AxisY, 0, 3, CRGB::Red, true);
+
+  for (int i = 0; i < 9; i++)
+    TEST_ASSERT_EQUAL_UINT8(i < 3 ? 255 : 0, h_LEDs[i].r);
+}
+
+void test_sweep_speed()
+{
+  static const size_t Sizes[] = { 16, 256, 4096 };
+  char message[128];
+
+  for (size_t size : Sizes)
+  {
+    size_t side = (size_t) sqrtf((float) size);
+    MakeMatrixCoords(coords, side, size / side, true);
+
+    LedLayout layout(size);
+    uint64_t nsLoad  = NanosPerCall([&]{ layout.Load(coords); }, 20);
+    uint64_t nsEvery = NanosPerCall([&]{ SweepEveryPixel(layout, AxisX, CRGB::Blue); SimAdvanceMillis(17); }, 500);
+    uint64_t nsWalk  = NanosPerCall([&]{ DrawPlaneSweep(layout, AxisX, CRGB::Blue); SimAdvanceMillis(17); }, 500);
+
+    snprintf(message, sizeof(message), "%u LEDs: Load %llu ns, sweep %llu ns walking the order, %llu ns measuring every pixel",
+             (unsigned) size, (unsigned long long) nsLoad, (unsigned long long) nsWalk, (unsigned long long) nsEvery);
+    TEST_MESSAGE(message);
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_orders_are_sorted);
+  RUN_TEST(test_sweep_strip);
+  RUN_TEST(test_sweep_ring);
+  RUN_TEST(test_sweep_matrix);
+  RUN_TEST(test_layout_pixels_follow_axis);
+  RUN_TEST(test_sweep_speed);
+  return UNITY_END();
+}
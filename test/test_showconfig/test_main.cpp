@@ -0,0 +1,213 @@
+//+--------------------------------------------------------------------------
+//
+// File:        test_main.cpp
+//
+// Description:
+//
+//      The saved show through the file stand-in for flash: saved, then put
+//      back by a fresh automation as if after a reboot, including the
+//      timelines that were animating parameters, and the time from boot to
+//      the restored effect's first frame on the strip.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#define NUM_LEDS        60
+#define UK_LEDS         30
+#define MATRIX_WIDTH    6
+#define MATRIX_HEIGHT   10
+
+#include "effectsuite.h"
+#include "showconfig.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#define SHOW_BOOT_BUDGET_US     5000            //  Restore plus the first frame, per effect
+
+static ShowStore            showStore;
+static ParameterAutomation  automation;
+static uint8_t              showTimelines[AUTOMATION_TIMELINE_BYTES];
+
+// A fresh automation with the sketch's parameters registered, as setup() leaves it
+
+static void Boot()
+{
+  automation = ParameterAutomation();
+  RegisterParameters(automation);
+}
+
+// What SaveShow in main.cpp does with the automation and the store
+
+static bool SaveShow(char effect, uint8_t transition)
+{
+  ShowConfig config = {};
+  config.effect        = effect;
+  config.transition    = transition;
+  config.schema        = automation.SchemaHash();
+  config.paramCount    = automation.Snapshot(config.params, AUTOMATION_MAX_PARAMS);
+  config.timelineBytes = automation.SaveTimelines(showTimelines);
+
+  return showStore.Save(config, showTimelines);
+}
+
+// RestoreShow
+//
+// The saved effect's key, or 0 if there was nothing to restore
+
+static char RestoreShow(ShowConfig & config)
+{
+  if (!showStore.Load(config, showTimelines))
+    return 0;
+
+  if (config.schema == automation.SchemaHash())
+  {
+    automation.Restore(config.params, config.paramCount);
+    automation.LoadTimelines(showTimelines, config.timelineBytes, millis());
+  }
+  return config.effect;
+}
+
+// Every test starts from a blank flash and the parameters at their defaults
+
+void setUp()
+{
+  char directory[] = "/tmp/showconfig.XXXXXX";
+  TEST_ASSERT_NOT_NULL(mkdtemp(directory));
+  SimFlashDirectory() = directory;
+
+  cometFadeAmt  = 64;
+  cometDeltaHue = 4;
+  cometSpeed    = 0.5;
+  Boot();
+}
+
+void tearDown()
+{
+  system(("rm -rf " + SimFlashDirectory()).c_str());
+}
+
+void test_nothing_saved()
+{
+  ShowConfig config;
+  TEST_ASSERT_EQUAL_INT(0, RestoreShow(config));
+}
+
+void test_show_round_trips()
+{
+  cometFadeAmt  = 100;
+  cometDeltaHue = 9;
+  TEST_ASSERT_TRUE(automation.Load("comet.speed 0=0.25 1000=2/3 2000=0.25", millis()));
+  TEST_ASSERT_TRUE(automation.Load("fire.cooling 0=20 500=80/6 1500=20", millis()));
+
+  automation.Evaluate(millis() + 700);
+  double speed   = cometSpeed;
+  TEST_ASSERT_TRUE(SaveShow('l', 1));
+
+  // Reboot: everything back to its defaults, then the show comes back from flash
+
+  cometFadeAmt  = 64;
+  cometDeltaHue = 4;
+  cometSpeed    = 0.5;
+  Boot();
+
+  ShowConfig config;
+  TEST_ASSERT_EQUAL_INT('l', RestoreShow(config));
+  TEST_ASSERT_EQUAL_UINT8(1, config.transition);
+  TEST_ASSERT_EQUAL_UINT8(100, cometFadeAmt);
+  TEST_ASSERT_EQUAL_INT(9, cometDeltaHue);
+
+  // The timelines start over from their first key, and go the same way as before
+
+  TEST_ASSERT_EQUAL_UINT32(2, automation.TrackCount());
+  automation.Evaluate(millis() + 700);
+  TEST_ASSERT_TRUE(fabs(cometSpeed - speed) < 0.001);
+}
+
+void test_timelines_need_the_same_parameters()
+{
+  TEST_ASSERT_TRUE(automation.Load("comet.speed 0=0.25 1000=2", millis()));
+  cometDeltaHue = 9;
+  TEST_ASSERT_TRUE(SaveShow('a', 0));
+
+  // A build with another parameter registered hashes differently, so none of it applies
+
+  static int extra = 0;
+  static const ParamBinding Extra[] = { { "extra", ParamInt, &extra } };
+  cometDeltaHue = 4;
+  Boot();
+  automation.Register("new", Extra, 1);
+
+  ShowConfig config;
+  TEST_ASSERT_EQUAL_INT('a', RestoreShow(config));
+  TEST_ASSERT_EQUAL_INT(4, cometDeltaHue);
+  TEST_ASSERT_EQUAL_UINT32(0, automation.TrackCount());
+}
+
+void test_damaged_timelines_are_dropped()
+{
+  TEST_ASSERT_TRUE(automation.Load("comet.speed 0=0.25 1000=2", millis()));
+  TEST_ASSERT_TRUE(SaveShow('a', 0));
+
+  // Lose the end of the timelines blob: the show still comes back, without them
+
+  std::string path = SimFlashDirectory() + "/" SHOW_CONFIG_NAMESPACE "/" SHOW_TIMELINE_KEY;
+  TEST_ASSERT_EQUAL_INT(0, truncate(path.c_str(), 5));
+
+  Boot();
+  ShowConfig config;
+  TEST_ASSERT_EQUAL_INT('a', RestoreShow(config));
+  TEST_ASSERT_EQUAL_UINT16(0, config.timelineBytes);
+  TEST_ASSERT_EQUAL_UINT32(0, automation.TrackCount());
+}
+
+void test_boot_to_first_frame()
+{
+  // For each effect, from the start of setup() to its first frame shown: the parameters registered,
+  // the show read back from flash, and one frame drawn and shown
+
+  char message[96];
+  uint64_t nsWorst = 0;
+  char     worst   = 0;
+
+  SetupSuite();
+  for (const LedEffect & effect : Effects)
+  {
+    Boot();
+    TEST_ASSERT_TRUE(automation.Load("comet.speed 0=0.25 1000=2/3 2000=0.25", millis()));
+    TEST_ASSERT_TRUE(SaveShow(effect.key, 0));
+
+    uint64_t nsStart = HostNanos();
+
+    Boot();
+    ShowConfig config;
+    const LedEffect * pSaved = FindLedEffect(RestoreShow(config));
+    TEST_ASSERT_NOT_NULL(pSaved);
+    pSaved->draw();
+    FastLED.show();
+
+    uint64_t ns = HostNanos() - nsStart;
+    if (ns > nsWorst)
+    {
+      nsWorst = ns;
+      worst   = effect.key;
+    }
+  }
+
+  snprintf(message, sizeof(message), "Boot to first frame: %llu us at worst, for '%c'", (unsigned long long) nsWorst / 1000, worst);
+  TEST_MESSAGE(message);
+
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(SHOW_BOOT_BUDGET_US, nsWorst / 1000);
+}
+
+int main(int argc, char ** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_nothing_saved);
+  RUN_TEST(test_show_round_trips);
+  RUN_TEST(test_timelines_need_the_same_parameters);
+  RUN_TEST(test_damaged_timelines_are_dropped);
+  RUN_TEST(test_boot_to_first_frame);
+  return UNITY_END();
+}
@@ -0,0 +1,179 @@
+//+--------------------------------------------------------------------------
+//
+// File:        test_main.cpp
+//
+// Description:
+//
+//      Checks the packed envelope pass in sparkle.h against the same rules
+//      applied one pixel at a time, over every possible pixel state, and
+//      reports how many pixels a second the engine gets through.
+//
+// History:     Oct-19-2026     tomwer      Created
+//                              tomwer      Timings reported, not compared
+//
+//---------------------------------------------------------------------------
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+#include <unity.h>
+#include <vector>
+
+#include "benchmark.h"
+#include "sparkle.h"
+
+#define BENCH_PIXELS    5000
+
+static const CRGB Colors[] = { CRGB::Red, CRGB::Blue, CRGB::Green };
+
+// Opens up the per-pixel state so the test can set any state it likes and read it back, as one 16-bit
+// value with the style in the high byte and the phase in the low one
+
+class TwinkleProbe : public TwinkleEngine
+{
+  public:
+
+    TwinkleProbe(size_t count)
+      : TwinkleEngine(count, Colors, sizeof(Colors) / sizeof(Colors[0]))
+    {
+    }
+
+    uint16_t State(size_t i) const
+    {
+      return _style[i] << 8 | _phase[i];
+    }
+
+    void SetState(size_t i, uint16_t state)
+    {
+      _style[i] = state >> 8;
+      _phase[i] = state & 0xFF;
+    }
+};
+
+void setUp()
+{
+  random16_set_seed(0x0380);
+}
+
+void tearDown() {}
+
+// Advance as the rules read: a dark pixel stays dark, a lit one moves on by (rate + 1) * 2 and
+// goes dark once it runs past the end of the envelope
+
+static uint16_t AdvancePixel(uint16_t state)
+{
+  uint16_t phase = state & 0xFF;
+  if (!phase)
+    return state;
+
+  phase += (((state >> 8) & 0x07) + 1) * 2;
+  return phase > 0xFF ? 0 : (state & 0xFF00) | phase;
+}
+
+static void AdvanceEach(std::vector<uint16_t> & states)
+{
+  for (uint16_t & state : states)
+    state = AdvancePixel(state);
+}
+
+void test_advance_matches_pixels()
+{
+  // Every 16-bit state once, on a count that leaves padding lanes in the last word, then a few more
+  // frames so the states the pass produces get checked too
+
+  const size_t count = 65537;
+  TwinkleProbe engine(count);
+  std::vector<uint16_t> expected(count);
+
+  for (size_t i = 0; i < count; i++)
+  {
+    expected[i] = (uint16_t) i;
+    engine.SetState(i, expected[i]);
+  }
+
+  for (int frame = 0; frame < 4; frame++)
+  {
+    engine.Advance();
+    AdvanceEach(expected);
+
+    for (size_t i = 0; i < count; i++)
+      if (engine.State(i) != expected[i])
+        TEST_ASSERT_EQUAL_UINT16(expected[i], engine.State(i));
+  }
+}
+
+void test_sparkles_run_their_course()
+{
+  // From a spawn to dark again takes between 16 and 128 frames, whatever the rate
+
+  TwinkleProbe engine(1);
+  engine.Spawn(1);
+  TEST_ASSERT_TRUE(engine.State(0) != 0);
+
+  int frames = 0;
+  while (engine.State(0) && frames < 1000)
+  {
+    engine.Advance();
+    frames++;
+  }
+  TEST_ASSERT_TRUE(frames >= 16 && frames <= 128);
+}
+
+void test_spawn_reaches_whole_strip()
+{
+  // Longer than random16 reaches: sparkles land past pixel 65535, and never past the end
+
+  const size_t count = 200001;
+  TwinkleProbe engine(count);
+  engine.Spawn(5000);
+
+  size_t beyond = 0;
+  for (size_t i = 65536; i < count; i++)
+    if (engine.State(i))
+      beyond++;
+  TEST_ASSERT_TRUE(beyond > 1000);
+
+  for (size_t i = count; i < (count + 3) / 4 * 4; i++)
+    TEST_ASSERT_EQUAL_UINT16(0, engine.State(i));
+}
+
+void test_pixels_per_second()
+{
+  TwinkleProbe engine(BENCH_PIXELS);
+  std::vector<uint16_t> states(BENCH_PIXELS);
+  static CRGB leds[BENCH_PIXELS];
+
+  // A couple of thousand sparkles going, as in a busy twinkle
+
+  for (int i = 0; i < 50; i++)
+  {
+    engine.Spawn(100);
+    engine.Advance();
+  }
+  for (size_t i = 0; i < BENCH_PIXELS; i++)
+    states[i] = engine.State(i);
+
+  uint64_t nsAdvance = NanosPerCall([&]{ engine.Advance(); }, 200);
+  uint64_t nsEach    = NanosPerCall([&]{ AdvanceEach(states); }, 200);
+  uint64_t nsDraw    = NanosPerCall([&]{ engine.Draw(leds); }, 200);
+
+  auto PixelsPerSecond = [](uint64_t ns) { return (unsigned long long)(BENCH_PIXELS * 1000000000ULL / max((uint64_t) 1, ns)); };
+
+  char message[160];
+  snprintf(message, sizeof(message), "Twinkle %d pixels: advance %llu pixels/s packed, %llu one at a time; draw %llu pixels/s",
+           BENCH_PIXELS, PixelsPerSecond(nsAdvance), PixelsPerSecond(nsEach), PixelsPerSecond(nsDraw));
+  TEST_MESSAGE(message);
+
+  // No comparison: on the host the compiler vectorizes the one-at-a-time loop over 16-bit states
+  // with SIMD, which the ESP32 doesn't have, so which wins here says nothing about the device
+}
+
+int main(int argc, char ** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_advance_matches_pixels);
+  RUN_TEST(test_sparkles_run_their_course);
+  RUN_TEST(test_spawn_reaches_whole_strip);
+  RUN_TEST(test_pixels_per_second);
+  return UNITY_END();
+}
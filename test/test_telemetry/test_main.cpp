@@ -0,0 +1,221 @@
+//+--------------------------------------------------------------------------
+//
+// File:        test_main.cpp
+//
+// Description:
+//
+//      The telemetry ring in telemetry.h: the record layout byte for byte
+//      against what tools/telemetry_csv.py unpacks, drains cut short by the
+//      budget or by the port, records going out whole so text on the same
+//      port falls between them, and the count of records dropped when the
+//      ring is full.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#include <Arduino.h>
+#include <unity.h>
+#include <stddef.h>
+#include <vector>
+
+#include "telemetry.h"
+
+#define RECORD_BYTES    sizeof(TelemetryRecord)
+
+// A port that keeps whatever it is sent, and takes at most 'accept' bytes per write when that isn't 0
+
+class CapturePort : public Print
+{
+  public:
+
+    std::vector<uint8_t> bytes;
+    size_t               accept = 0;
+
+    size_t write(uint8_t c) override
+    {
+      bytes.push_back(c);
+      return 1;
+    }
+
+    size_t write(const uint8_t * buffer, size_t size) override
+    {
+      if (accept)
+        size = min(size, accept);
+      bytes.insert(bytes.end(), buffer, buffer + size);
+      return size;
+    }
+};
+
+static TelemetryRecord Sample(uint32_t ms)
+{
+  TelemetryRecord record = {};
+  record.msUptime        = ms;
+  record.usFrame         = 812;
+  record.usShow          = 1805;
+  record.fps             = 61;
+  record.powerMilliwatts = 2450;
+  record.brightness      = 128;
+  record.throttleEvents  = 3;
+  record.freeHeap        = 180224;
+  record.effect          = 'l';
+  return record;
+}
+
+// Checks one record as the decoder would: sync, version, length, checksum, and the sequence it should have
+
+static void CheckRecord(const uint8_t * bytes, uint16_t sequence)
+{
+  TEST_ASSERT_EQUAL_UINT8(TELEMETRY_SYNC0, bytes[0]);
+  TEST_ASSERT_EQUAL_UINT8(TELEMETRY_SYNC1, bytes[1]);
+  TEST_ASSERT_EQUAL_UINT8(TELEMETRY_VERSION, bytes[2]);
+  TEST_ASSERT_EQUAL_UINT8(RECORD_BYTES, bytes[3]);
+  TEST_ASSERT_EQUAL_UINT16(sequence, bytes[4] | bytes[5] << 8);
+
+  uint8_t checksum = 0;
+  for (size_t i = 0; i < RECORD_BYTES - 1; i++)
+    checksum ^= bytes[i];
+  TEST_ASSERT_EQUAL_UINT8(checksum, bytes[RECORD_BYTES - 1]);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_layout_matches_decoder()
+{
+  // RECORD in tools/telemetry_csv.py is '<HIIIHIBHIcH' after the four header bytes, then the checksum:
+  // each field must start where the struct format puts it
+
+  static const char Format[] = "HIIIHIBHIcH";
+  static const size_t Offsets[] =
+  {
+    offsetof(TelemetryRecord, sequence),        offsetof(TelemetryRecord, msUptime),
+    offsetof(TelemetryRecord, usFrame),         offsetof(TelemetryRecord, usShow),
+    offsetof(TelemetryRecord, fps),             offsetof(TelemetryRecord, powerMilliwatts),
+    offsetof(TelemetryRecord, brightness),      offsetof(TelemetryRecord, throttleEvents),
+    offsetof(TelemetryRecord, freeHeap),        offsetof(TelemetryRecord, effect),
+    offsetof(TelemetryRecord, dropped),
+  };
+
+  size_t offset = 4;
+  for (size_t i = 0; i < sizeof(Offsets) / sizeof(Offsets[0]); i++)
+  {
+    TEST_ASSERT_EQUAL_UINT32(offset, Offsets[i]);
+    offset += Format[i] == 'I' ? 4 : Format[i] == 'H' ? 2 : 1;
+  }
+  TEST_ASSERT_EQUAL_UINT32(offset, offsetof(TelemetryRecord, checksum));
+  TEST_ASSERT_EQUAL_UINT32(offset + 1, RECORD_BYTES);
+
+  // Little endian on the wire, as '<' says
+
+  TelemetryStream stream;
+  CapturePort     port;
+  TelemetryRecord record = Sample(0x01020304);
+
+  stream.Record(record);
+  stream.Drain(port, RECORD_BYTES);
+  TEST_ASSERT_EQUAL_UINT32(RECORD_BYTES, port.bytes.size());
+  CheckRecord(port.bytes.data(), 0);
+
+  const uint8_t Uptime[] = { 0x04, 0x03, 0x02, 0x01 };
+  TEST_ASSERT_EQUAL_MEMORY(Uptime, &port.bytes[offsetof(TelemetryRecord, msUptime)], 4);
+  TEST_ASSERT_EQUAL_UINT8('l', port.bytes[offsetof(TelemetryRecord, effect)]);
+}
+
+void test_budget_sends_whole_records()
+{
+  // A budget that isn't a multiple of the record sends the whole records that fit and no more, so
+  // the stats line printed between two drains can't end up inside a record
+
+  TelemetryStream stream;
+  CapturePort     port;
+
+  for (int i = 0; i < 5; i++)
+  {
+    TelemetryRecord record = Sample(i * 100);
+    stream.Record(record);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(0, stream.Drain(port, RECORD_BYTES - 1));
+  TEST_ASSERT_EQUAL_UINT32(RECORD_BYTES, stream.Drain(port, RECORD_BYTES * 2 - 1));
+  port.print("Blend 12 us\r\n");
+  TEST_ASSERT_EQUAL_UINT32(RECORD_BYTES * 3, stream.Drain(port, RECORD_BYTES * 3 + 20));
+  TEST_ASSERT_EQUAL_UINT32(RECORD_BYTES, stream.Pending());
+  TEST_ASSERT_EQUAL_UINT32(RECORD_BYTES, stream.Drain(port, 1000));
+  TEST_ASSERT_EQUAL_UINT32(0, stream.Pending());
+
+  // The text sits between the first and second records, and every record is intact
+
+  const size_t text = strlen("Blend 12 us\r\n");
+  CheckRecord(&port.bytes[0], 0);
+  for (int i = 1; i < 5; i++)
+    CheckRecord(&port.bytes[RECORD_BYTES * i + text], i);
+}
+
+void test_short_writes_finish_the_record()
+{
+  // A port that takes 10 bytes at a time splits records; what it didn't take goes first next time,
+  // and the stream comes out the same as if it had been sent in one go.  Enough records go through
+  // to wrap the ring several times, with records straddling the wrap.
+
+  TelemetryStream stream;
+  CapturePort     port;
+  port.accept = 10;
+
+  const int records = TELEMETRY_RING_SIZE / RECORD_BYTES * 3;
+  int recorded = 0;
+
+  while (recorded < records || stream.Pending())
+  {
+    if (recorded < records && stream.Pending() < TELEMETRY_RING_SIZE / 2)
+    {
+      TelemetryRecord record = Sample(recorded * 100);
+      TEST_ASSERT_TRUE(stream.Record(record));
+      recorded++;
+    }
+    stream.Drain(port, 64);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(records * RECORD_BYTES, port.bytes.size());
+  for (int i = 0; i < records; i++)
+    CheckRecord(&port.bytes[RECORD_BYTES * i], i);
+  TEST_ASSERT_EQUAL_UINT16(0, stream.Dropped());
+}
+
+void test_full_ring_drops_and_counts()
+{
+  // With nothing draining, the ring takes as many whole records as fit and counts the rest; the next
+  // record sent says how many went missing, and its sequence number shows the gap
+
+  TelemetryStream stream;
+  CapturePort     port;
+
+  const int fit = TELEMETRY_RING_SIZE / RECORD_BYTES;
+  for (int i = 0; i < fit + 3; i++)
+  {
+    TelemetryRecord record = Sample(i);
+    TEST_ASSERT_EQUAL(i < fit, stream.Record(record));
+  }
+  TEST_ASSERT_EQUAL_UINT16(3, stream.Dropped());
+
+  stream.Drain(port, TELEMETRY_RING_SIZE);
+  TEST_ASSERT_EQUAL_UINT32(fit * RECORD_BYTES, port.bytes.size());
+
+  TelemetryRecord record = Sample(0);
+  stream.Record(record);
+  stream.Drain(port, RECORD_BYTES);
+
+  const uint8_t * last = &port.bytes[fit * RECORD_BYTES];
+  CheckRecord(last, fit + 3);
+  TEST_ASSERT_EQUAL_UINT16(3, last[offsetof(TelemetryRecord, dropped)] | last[offsetof(TelemetryRecord, dropped) + 1] << 8);
+}
+
+int main(int argc, char ** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_layout_matches_decoder);
+  RUN_TEST(test_budget_sends_whole_records);
+  RUN_TEST(test_short_writes_finish_the_record);
+  RUN_TEST(test_full_ring_drops_and_counts);
+  return UNITY_END();
+}
@@ -0,0 +1,143 @@
+//+--------------------------------------------------------------------------
+//
+// File:        test_main.cpp
+//
+// Description:
+//
+//      Runs the timer wheel the way EventLoop does, sleeping until
+//      NextDeadline() and then calling Advance(), for 30 simulated hours
+//      with 300 one-shot and periodic timers, starting just before
+//      millis() wraps.  Every timer must fire on the very tick it is due,
+//      and none may be skipped.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#include <Arduino.h>
+#include <unity.h>
+#include <math.h>
+
+#include "timerwheel.h"
+
+#define SIM_TIMERS          300
+#define SIM_HOURS           30
+#define SIM_START_MS        (0xFFFFFFFFUL - 90000)      //  90 seconds before the 32-bit wrap
+#define SIM_INPUT_MS        30000                       //  Average gap between wakeups for input
+
+// One timer under test, with its deadline kept in 64 bits so it can't wrap
+
+struct Probe
+{
+  WheelTimer  timer;
+  uint64_t    msDue;
+  uint32_t    msPeriod;
+};
+
+static TimerWheel wheel;
+static Probe      probes[SIM_TIMERS];
+static uint64_t   msNow64;
+static uint32_t   lateFirings;
+static uint32_t   earlyFirings;
+static uint64_t   totalFirings;
+
+void setUp()
+{
+  randomSeed(0x0330);
+}
+
+void tearDown() {}
+
+// Log-uniform between lo and hi, so there are timers at every scale from milliseconds to hours
+
+static uint32_t RandomSpan(uint32_t lo, uint32_t hi)
+{
+  double exponent = random(1000000) / 1000000.0;
+  return (uint32_t)(lo * pow((double) hi / lo, exponent));
+}
+
+static void Arm(Probe & probe, uint32_t msDelay)
+{
+  wheel.Add(probe.timer, (uint32_t) msNow64, msDelay, probe.msPeriod);
+  probe.msDue = msNow64 + msDelay;
+}
+
+static void Fired(void * pContext)
+{
+  Probe & probe = *(Probe *) pContext;
+
+  lateFirings  += msNow64 > probe.msDue;
+  earlyFirings += msNow64 < probe.msDue;
+  totalFirings++;
+
+  // A one-shot goes again after a new delay, some of them past the wheel's 18 hour reach
+
+  if (probe.msPeriod)
+    probe.msDue += probe.msPeriod;
+  else
+    Arm(probe, RandomSpan(1, 20 * 3600000UL));
+}
+
+void test_thirty_hours_across_the_wrap()
+{
+  msNow64 = SIM_START_MS;
+  wheel.Begin(SIM_START_MS);
+
+  // Half periodic, from a frame timer up to two hours, and half one-shot
+
+  for (int i = 0; i < SIM_TIMERS; i++)
+  {
+    Probe & probe = probes[i];
+    probe.timer    = WheelTimer(Fired, &probe);
+    probe.msPeriod = i & 1 ? 0 : (i < 4 ? 16 : RandomSpan(100, 2 * 3600000UL));
+    Arm(probe, RandomSpan(1, 20 * 3600000UL));
+  }
+
+  const uint64_t msEnd = SIM_START_MS + (uint64_t) SIM_HOURS * 3600000UL;
+  uint64_t msInput = msNow64 + random(SIM_INPUT_MS * 2);
+  uint32_t wakeups = 0;
+
+  while (msNow64 < msEnd)
+  {
+    // Sleep until the wheel's next deadline, or wake early for a key press that moves a timer
+
+    uint32_t msWait = wheel.NextDeadline((uint32_t) msNow64);
+    TEST_ASSERT_TRUE(msWait != WHEEL_NO_DEADLINE);
+
+    bool bInput = msInput < msNow64 + msWait;
+    msNow64 = bInput ? msInput : msNow64 + msWait;
+    wheel.Advance((uint32_t) msNow64);
+    wakeups++;
+
+    if (bInput)
+    {
+      Probe & probe = probes[random(SIM_TIMERS)];
+      wheel.Remove(probe.timer);
+      Arm(probe, RandomSpan(1, 3600000UL));
+      msInput = msNow64 + random(SIM_INPUT_MS * 2);
+    }
+  }
+
+  // Anything due before the end that hasn't fired was missed
+
+  uint32_t missed = 0;
+  for (const Probe & probe : probes)
+    missed += probe.msDue <= msNow64;
+
+  char message[128];
+  snprintf(message, sizeof(message), "%llu firings and %u wakeups over %d hours: %u late, %u early, %u missed",
+           (unsigned long long) totalFirings, wakeups, SIM_HOURS, lateFirings, earlyFirings, missed);
+  TEST_MESSAGE(message);
+
+  TEST_ASSERT_TRUE((uint32_t) msNow64 < SIM_START_MS);        //  the clock really did wrap
+  TEST_ASSERT_EQUAL_UINT32(0, lateFirings);
+  TEST_ASSERT_EQUAL_UINT32(0, earlyFirings);
+  TEST_ASSERT_EQUAL_UINT32(0, missed);
+}
+
+int main(int argc, char ** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_thirty_hours_across_the_wrap);
+  return UNITY_END();
+}
@@ -0,0 +1,137 @@
+//+--------------------------------------------------------------------------
+//
+// File:        test_main.cpp
+//
+// Description:
+//
+//      Checks the packed crossfade in transition.h against a plain per-byte
+//      lerp and times the two side by side at a few strip lengths, and
+//      checks what a transition started on top of another one blends from.
+//
+// History:     Oct-19-2026     tomwer      Created
+//
+//---------------------------------------------------------------------------
+
+#include <Arduino.h>
+#define FASTLED_INTERNAL
+#include <FastLED.h>
+#include <unity.h>
+
+#include "benchmark.h"
+
+#define NUM_LEDS    5000
+
+CRGB h_LEDs[NUM_LEDS];
+
+#include "transition.h"
+
+static CRGB fromLEDs[NUM_LEDS];
+static CRGB toLEDs[NUM_LEDS];
+static CRGB expected[NUM_LEDS];
+
+// The blend as it was before it was packed: one multiply-add per channel
+
+void BlendBytes(CRGB * out, const CRGB * from, const CRGB * to, size_t count, uint16_t amount)
+{
+  for (size_t i = 0; i < count; i++)
+    for (int c = 0; c < 3; c++)
+      out[i][c] = (from[i][c] * (256 - amount) + to[i][c] * amount) >> 8;
+}
+
+void setUp()
+{
+  random16_set_seed(0x2604);
+  for (int i = 0; i < NUM_LEDS; i++)
+  {
+    fromLEDs[i] = CRGB(random8(), random8(), random8());
+    toLEDs[i]   = CRGB(random8(), random8(), random8());
+  }
+}
+
+void tearDown() {}
+
+void test_blend_matches_bytes()
+{
+  // Odd lengths leave a tail of bytes for the scalar loop to finish
+
+  static const size_t Lengths[] = { 1, 2, 3, 5, 60, 61, 1001 };
+
+  for (size_t length : Lengths)
+  {
+    for (uint16_t amount = 0; amount <= 256; amount++)
+    {
+      BlendBytes(expected, fromLEDs, toLEDs, length, amount);
+      BlendBuffers(h_LEDs, fromLEDs, toLEDs, length, amount);
+      TEST_ASSERT_EQUAL_MEMORY(expected, h_LEDs, length * sizeof(CRGB));
+    }
+  }
+}
+
+void test_blend_ends()
+{
+  BlendBuffers(h_LEDs, fromLEDs, toLEDs, NUM_LEDS, 0);
+  TEST_ASSERT_EQUAL_MEMORY(fromLEDs, h_LEDs, sizeof(h_LEDs));
+
+  BlendBuffers(h_LEDs, fromLEDs, toLEDs, NUM_LEDS, 256);
+  TEST_ASSERT_EQUAL_MEMORY(toLEDs, h_LEDs, sizeof(h_LEDs));
+}
+
+// Draw functions for the engine: each fills the strip with its own color
+
+static void DrawRed()   { fill_solid(h_LEDs, 60, CRGB::Red); }
+static void DrawGreen() { fill_solid(h_LEDs, 60, CRGB::Green); }
+static void DrawBlue()  { fill_solid(h_LEDs, 60, CRGB::Blue); }
+
+void test_restart_keeps_incoming_frame()
+{
+  // Red out, green in; a key halfway through starts blue, and green has to go out as green
+  // whatever the strip was left holding
+
+  TransitionEngine engine(60);
+
+  DrawRed();
+  engine.Start(Crossfade, 1000);
+  engine.DrawOutgoing(DrawRed);
+  engine.DrawIncoming(DrawGreen);
+  SimAdvanceMillis(500);
+  engine.Compose();
+  engine.DrawOutgoing(DrawRed);                       //  the outgoing side drew last
+
+  engine.Start(Crossfade, 1000);
+  engine.DrawIncoming(DrawBlue);
+  engine.Compose();
+  for (int i = 0; i < 60; i++)
+    TEST_ASSERT_TRUE(h_LEDs[i] == CRGB(CRGB::Green));
+
+  SimAdvanceMillis(1000);
+  engine.Compose();
+  TEST_ASSERT_FALSE(engine.IsActive());
+  TEST_ASSERT_TRUE(h_LEDs[0] == CRGB(CRGB::Blue));
+}
+
+void test_blend_speed()
+{
+  static const size_t Lengths[] = { 60, 1000, 5000 };
+  char message[96];
+
+  for (size_t length : Lengths)
+  {
+    uint16_t amount = 0;
+    uint64_t nsPacked = NanosPerCall([&]{ BlendBuffers(h_LEDs, fromLEDs, toLEDs, length, amount++ & 0xFF); }, 200);
+    uint64_t nsBytes  = NanosPerCall([&]{ BlendBytes(h_LEDs, fromLEDs, toLEDs, length, amount++ & 0xFF); }, 200);
+
+    snprintf(message, sizeof(message), "Blend %u LEDs: packed %llu ns, per byte %llu ns", (unsigned) length,
+             (unsigned long long) nsPacked, (unsigned long long) nsBytes);
+    TEST_MESSAGE(message);
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_blend_matches_bytes);
+  RUN_TEST(test_blend_ends);
+  RUN_TEST(test_restart_keeps_incoming_frame);
+  RUN_TEST(test_blend_speed);
+  return UNITY_END();
+}
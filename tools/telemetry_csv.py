@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+#+--------------------------------------------------------------------------
+#
+# File:        telemetry_csv.py
+#
+# Description:
+#
+#      Turns a capture of the binary telemetry stream from telemetry.h into
+#      CSV, one row per record.  The capture can be a file saved from a
+#      serial terminal or a serial port read directly (needs pyserial); text
+#      mixed into the stream, like the stats lines on Serial, is skipped by
+#      resyncing on the record header and checksum.  At the end a summary on
+#      stderr says how many bytes were skipped and how many records never
+#      arrived, from gaps in the sequence numbers, and how many of those the
+#      device itself dropped.
+#
+#        python tools/telemetry_csv.py capture.bin > soak.csv
+#        python tools/telemetry_csv.py --port COM8 --baud 115200 -o soak.csv
+#
+# History:     Oct-19-2026     tomwer      Created
+#                              tomwer      Reports skipped bytes and missing records
+#
+#---------------------------------------------------------------------------
+
+import argparse
+import csv
+import struct
+import sys
+
+SYNC    = b'\xA5\x5A'
+VERSION = 1
+
+# Everything after sync, version and length; see the layout in telemetry.h
+RECORD  = struct.Struct('<HIIIHIBHIcH')
+LENGTH  = 4 + RECORD.size + 1
+
+FIELDS  = ['sequence', 'ms_uptime', 'us_frame', 'us_show', 'fps', 'power_mw', 'brightness',
+           'throttle_events', 'free_heap', 'effect', 'dropped']
+
+
+class Losses:
+    """What didn't make it into the CSV"""
+
+    def __init__(self):
+        self.records = 0
+        self.skipped = 0                    # bytes that weren't part of a valid record
+        self.missing = 0                    # records missing from the sequence
+        self.dropped = 0                    # of those, dropped on the device because its ring was full
+        self.sequence = None
+        self.device_dropped = None
+
+    def record(self, row):
+        if self.sequence is not None:
+            self.missing += (row['sequence'] - self.sequence - 1) & 0xFFFF
+            self.dropped += (row['dropped'] - self.device_dropped) & 0xFFFF
+        self.sequence = row['sequence']
+        self.device_dropped = row['dropped']
+        self.records += 1
+
+    def summary(self):
+        return ('%d records; %d bytes of other output skipped; %d records missing, %d of them dropped on the device'
+                % (self.records, self.skipped, self.missing, self.dropped))
+
+
+def records(chunks, losses=None):
+    """Yields each valid record as a dict from an iterable of byte chunks, counting what it skips in losses"""
+
+    losses = losses or Losses()
+    buffer = bytearray()
+    for chunk in chunks:
+        buffer += chunk
+        while True:
+            start = buffer.find(SYNC)
+            if start < 0:
+                losses.skipped += max(0, len(buffer) - 1)
+                del buffer[:-1]
+                break
+            losses.skipped += start
+            del buffer[:start]
+            if len(buffer) < LENGTH:
+                break
+
+            frame = bytes(buffer[:LENGTH])
+            checksum = 0
+            for b in frame[:-1]:
+                checksum ^= b
+
+            if frame[2] != VERSION or frame[3] != LENGTH or checksum != frame[-1]:
+                losses.skipped += 1
+                del buffer[:1]                      # not a record after all; look for the next sync
+                continue
+
+            values = RECORD.unpack_from(frame, 4)
+            row = dict(zip(FIELDS, values))
+            row['effect'] = row['effect'].decode('latin-1').strip('\0')
+            losses.record(row)
+            yield row
+            del buffer[:LENGTH]
+
+    losses.skipped += len(buffer)
+
+
+def read_file(path):
+    with open(path, 'rb') as f:
+        while True:
+            chunk = f.read(4096)
+            if not chunk:
+                return
+            yield chunk
+
+
+def read_port(port, baud):
+    import serial
+    with serial.Serial(port, baud, timeout=1) as s:
+        while True:
+            yield s.read(s.in_waiting or 1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode LED telemetry records to CSV')
+    parser.add_argument('capture', nargs='?', help='binary capture file')
+    parser.add_argument('--port', help='read live from this serial port instead')
+    parser.add_argument('--baud', type=int, default=115200)
+    parser.add_argument('-o', '--output', help='CSV file to write, default stdout')
+    args = parser.parse_args()
+
+    if not args.capture and not args.port:
+        parser.error('give a capture file or --port')
+
+    source = read_port(args.port, args.baud) if args.port else read_file(args.capture)
+    out = open(args.output, 'w', newline='') if args.output else sys.stdout
+
+    writer = csv.DictWriter(out, fieldnames=FIELDS)
+    writer.writeheader()
+    losses = Losses()
+    try:
+        for row in records(source, losses):
+            writer.writerow(row)
+            out.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if out is not sys.stdout:
+            out.close()
+        print(losses.summary(), file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()